@@ -0,0 +1,34 @@
+#pragma once
+#ifndef __AABB__
+#define __AABB__
+#include <glm/vec2.hpp>
+#include <glm/common.hpp>
+
+struct AABB
+{
+	glm::vec2 lowerBound; // top left
+	glm::vec2 upperBound; // bottom right
+
+	float getPerimeter() const
+	{
+		return 2.0f * ((upperBound.x - lowerBound.x) + (upperBound.y - lowerBound.y));
+	}
+
+	bool contains(const AABB& other) const
+	{
+		return lowerBound.x <= other.lowerBound.x && lowerBound.y <= other.lowerBound.y &&
+			other.upperBound.x <= upperBound.x && other.upperBound.y <= upperBound.y;
+	}
+
+	bool overlaps(const AABB& other) const
+	{
+		return lowerBound.x < other.upperBound.x && upperBound.x > other.lowerBound.x &&
+			lowerBound.y < other.upperBound.y && upperBound.y > other.lowerBound.y;
+	}
+
+	static AABB combine(const AABB& a, const AABB& b)
+	{
+		return { glm::min(a.lowerBound, b.lowerBound), glm::max(a.upperBound, b.upperBound) };
+	}
+};
+#endif /* defined (__AABB__) */
@@ -0,0 +1,380 @@
+#include "AABBTree.h"
+
+#include <algorithm>
+#include <cassert>
+
+AABBTree::AABBTree() : m_root(NULL_NODE), m_freeList(NULL_NODE)
+{
+}
+
+AABBTree::~AABBTree()
+= default;
+
+int AABBTree::createProxy(DisplayObject* object)
+{
+	const auto proxy_id = m_allocateNode();
+
+	// fatten the bounds so the proxy can move a little without being re-inserted
+	const auto margin = glm::vec2(FAT_MARGIN, FAT_MARGIN);
+	const auto aabb = computeAABB(object);
+	m_nodes[proxy_id].aabb = { aabb.lowerBound - margin, aabb.upperBound + margin };
+	m_nodes[proxy_id].object = object;
+	m_nodes[proxy_id].height = 0;
+
+	m_insertLeaf(proxy_id);
+	return proxy_id;
+}
+
+void AABBTree::destroyProxy(const int proxy_id)
+{
+	assert(m_nodes[proxy_id].isLeaf());
+
+	m_removeLeaf(proxy_id);
+	m_freeNode(proxy_id);
+}
+
+bool AABBTree::moveProxy(const int proxy_id)
+{
+	assert(m_nodes[proxy_id].isLeaf());
+
+	const auto aabb = computeAABB(m_nodes[proxy_id].object);
+	if (m_nodes[proxy_id].aabb.contains(aabb))
+	{
+		return false; // still inside the fattened bounds
+	}
+
+	m_removeLeaf(proxy_id);
+
+	const auto margin = glm::vec2(FAT_MARGIN, FAT_MARGIN);
+	m_nodes[proxy_id].aabb = { aabb.lowerBound - margin, aabb.upperBound + margin };
+
+	m_insertLeaf(proxy_id);
+	return true;
+}
+
+void AABBTree::clear()
+{
+	m_nodes.clear();
+	m_root = NULL_NODE;
+	m_freeList = NULL_NODE;
+}
+
+DisplayObject* AABBTree::getObject(const int proxy_id) const
+{
+	return m_nodes[proxy_id].object;
+}
+
+const AABB& AABBTree::getFatAABB(const int proxy_id) const
+{
+	return m_nodes[proxy_id].aabb;
+}
+
+int AABBTree::getHeight() const
+{
+	return (m_root == NULL_NODE) ? 0 : m_nodes[m_root].height;
+}
+
+AABB AABBTree::computeAABB(GameObject* object)
+{
+	return object->getBounds();
+}
+
+int AABBTree::m_allocateNode()
+{
+	// grow the pool when the free list is empty
+	if (m_freeList == NULL_NODE)
+	{
+		TreeNode node{};
+		node.parent = NULL_NODE;
+		node.child1 = NULL_NODE;
+		node.child2 = NULL_NODE;
+		node.height = -1;
+		m_nodes.push_back(node);
+		return static_cast<int>(m_nodes.size()) - 1;
+	}
+
+	const auto node_id = m_freeList;
+	m_freeList = m_nodes[node_id].parent;
+	m_nodes[node_id].parent = NULL_NODE;
+	m_nodes[node_id].child1 = NULL_NODE;
+	m_nodes[node_id].child2 = NULL_NODE;
+	m_nodes[node_id].object = nullptr;
+	m_nodes[node_id].height = 0;
+	return node_id;
+}
+
+void AABBTree::m_freeNode(const int node_id)
+{
+	m_nodes[node_id].parent = m_freeList;
+	m_nodes[node_id].height = -1;
+	m_freeList = node_id;
+}
+
+void AABBTree::m_insertLeaf(const int leaf)
+{
+	if (m_root == NULL_NODE)
+	{
+		m_root = leaf;
+		m_nodes[m_root].parent = NULL_NODE;
+		return;
+	}
+
+	// find the best sibling using the surface area (perimeter) heuristic
+	const auto leaf_aabb = m_nodes[leaf].aabb;
+	auto index = m_root;
+	while (!m_nodes[index].isLeaf())
+	{
+		const auto child1 = m_nodes[index].child1;
+		const auto child2 = m_nodes[index].child2;
+
+		const auto area = m_nodes[index].aabb.getPerimeter();
+		const auto combined_area = AABB::combine(m_nodes[index].aabb, leaf_aabb).getPerimeter();
+
+		// cost of creating a new parent for this node and the new leaf
+		const auto cost = 2.0f * combined_area;
+
+		// minimum cost of pushing the leaf further down the tree
+		const auto inheritance_cost = 2.0f * (combined_area - area);
+
+		auto child_cost = [&](const int child)
+		{
+			const auto combined = AABB::combine(leaf_aabb, m_nodes[child].aabb).getPerimeter();
+			if (m_nodes[child].isLeaf())
+			{
+				return combined + inheritance_cost;
+			}
+			return (combined - m_nodes[child].aabb.getPerimeter()) + inheritance_cost;
+		};
+
+		const auto cost1 = child_cost(child1);
+		const auto cost2 = child_cost(child2);
+
+		// descend according to the minimum cost
+		if (cost < cost1 && cost < cost2)
+		{
+			break;
+		}
+
+		index = (cost1 < cost2) ? child1 : child2;
+	}
+
+	const auto sibling = index;
+
+	// create a new parent for the sibling and the leaf
+	const auto old_parent = m_nodes[sibling].parent;
+	const auto new_parent = m_allocateNode();
+	m_nodes[new_parent].parent = old_parent;
+	m_nodes[new_parent].aabb = AABB::combine(leaf_aabb, m_nodes[sibling].aabb);
+	m_nodes[new_parent].height = m_nodes[sibling].height + 1;
+	m_nodes[new_parent].child1 = sibling;
+	m_nodes[new_parent].child2 = leaf;
+	m_nodes[sibling].parent = new_parent;
+	m_nodes[leaf].parent = new_parent;
+
+	if (old_parent != NULL_NODE)
+	{
+		if (m_nodes[old_parent].child1 == sibling)
+		{
+			m_nodes[old_parent].child1 = new_parent;
+		}
+		else
+		{
+			m_nodes[old_parent].child2 = new_parent;
+		}
+	}
+	else
+	{
+		m_root = new_parent;
+	}
+
+	// walk back up the tree fixing heights and bounds
+	index = m_nodes[leaf].parent;
+	while (index != NULL_NODE)
+	{
+		index = m_balance(index);
+
+		const auto child1 = m_nodes[index].child1;
+		const auto child2 = m_nodes[index].child2;
+		m_nodes[index].height = 1 + std::max(m_nodes[child1].height, m_nodes[child2].height);
+		m_nodes[index].aabb = AABB::combine(m_nodes[child1].aabb, m_nodes[child2].aabb);
+
+		index = m_nodes[index].parent;
+	}
+}
+
+void AABBTree::m_removeLeaf(const int leaf)
+{
+	if (leaf == m_root)
+	{
+		m_root = NULL_NODE;
+		return;
+	}
+
+	const auto parent = m_nodes[leaf].parent;
+	const auto grand_parent = m_nodes[parent].parent;
+	const auto sibling = (m_nodes[parent].child1 == leaf) ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+	if (grand_parent == NULL_NODE)
+	{
+		m_root = sibling;
+		m_nodes[sibling].parent = NULL_NODE;
+		m_freeNode(parent);
+		return;
+	}
+
+	// destroy the parent and connect the sibling to the grand parent
+	if (m_nodes[grand_parent].child1 == parent)
+	{
+		m_nodes[grand_parent].child1 = sibling;
+	}
+	else
+	{
+		m_nodes[grand_parent].child2 = sibling;
+	}
+	m_nodes[sibling].parent = grand_parent;
+	m_freeNode(parent);
+
+	// adjust ancestor bounds
+	auto index = grand_parent;
+	while (index != NULL_NODE)
+	{
+		index = m_balance(index);
+
+		const auto child1 = m_nodes[index].child1;
+		const auto child2 = m_nodes[index].child2;
+		m_nodes[index].aabb = AABB::combine(m_nodes[child1].aabb, m_nodes[child2].aabb);
+		m_nodes[index].height = 1 + std::max(m_nodes[child1].height, m_nodes[child2].height);
+
+		index = m_nodes[index].parent;
+	}
+}
+
+/*
+ * Performs a left or right rotation if node A is imbalanced and returns the new root of the subtree
+ *
+ *         A
+ *       /   \
+ *      B     C
+ *     / \   / \
+ *    D   E F   G
+ */
+int AABBTree::m_balance(const int node_id)
+{
+	const auto iA = node_id;
+	auto& A = m_nodes[iA];
+	if (A.isLeaf() || A.height < 2)
+	{
+		return iA;
+	}
+
+	const auto iB = A.child1;
+	const auto iC = A.child2;
+	const auto balance = m_nodes[iC].height - m_nodes[iB].height;
+
+	// rotate C up
+	if (balance > 1)
+	{
+		const auto iF = m_nodes[iC].child1;
+		const auto iG = m_nodes[iC].child2;
+
+		// swap A and C
+		m_nodes[iC].child1 = iA;
+		m_nodes[iC].parent = A.parent;
+		A.parent = iC;
+
+		// A's old parent should point to C
+		if (m_nodes[iC].parent != NULL_NODE)
+		{
+			auto& C_parent = m_nodes[m_nodes[iC].parent];
+			(C_parent.child1 == iA ? C_parent.child1 : C_parent.child2) = iC;
+		}
+		else
+		{
+			m_root = iC;
+		}
+
+		// rotate the taller grand child up with C
+		const auto keep = (m_nodes[iF].height > m_nodes[iG].height) ? iF : iG;
+		const auto move = (keep == iF) ? iG : iF;
+		m_nodes[iC].child2 = keep;
+		A.child2 = move;
+		m_nodes[move].parent = iA;
+		A.aabb = AABB::combine(m_nodes[iB].aabb, m_nodes[move].aabb);
+		m_nodes[iC].aabb = AABB::combine(A.aabb, m_nodes[keep].aabb);
+
+		A.height = 1 + std::max(m_nodes[iB].height, m_nodes[move].height);
+		m_nodes[iC].height = 1 + std::max(A.height, m_nodes[keep].height);
+
+		return iC;
+	}
+
+	// rotate B up
+	if (balance < -1)
+	{
+		const auto iD = m_nodes[iB].child1;
+		const auto iE = m_nodes[iB].child2;
+
+		// swap A and B
+		m_nodes[iB].child1 = iA;
+		m_nodes[iB].parent = A.parent;
+		A.parent = iB;
+
+		// A's old parent should point to B
+		if (m_nodes[iB].parent != NULL_NODE)
+		{
+			auto& B_parent = m_nodes[m_nodes[iB].parent];
+			(B_parent.child1 == iA ? B_parent.child1 : B_parent.child2) = iB;
+		}
+		else
+		{
+			m_root = iB;
+		}
+
+		// rotate the taller grand child up with B
+		const auto keep = (m_nodes[iD].height > m_nodes[iE].height) ? iD : iE;
+		const auto move = (keep == iD) ? iE : iD;
+		m_nodes[iB].child2 = keep;
+		A.child1 = move;
+		m_nodes[move].parent = iA;
+		A.aabb = AABB::combine(m_nodes[iC].aabb, m_nodes[move].aabb);
+		m_nodes[iB].aabb = AABB::combine(A.aabb, m_nodes[keep].aabb);
+
+		A.height = 1 + std::max(m_nodes[iC].height, m_nodes[move].height);
+		m_nodes[iB].height = 1 + std::max(A.height, m_nodes[keep].height);
+
+		return iB;
+	}
+
+	return iA;
+}
+
+bool AABBTree::m_segmentOverlaps(const glm::vec2 start_point, const glm::vec2 direction, const glm::vec2 inverse_direction, const AABB& aabb)
+{
+	// slab test - clip the segment parameter range [0, 1] against each axis, as CollisionManager::segmentAABBCheck does
+	auto entry = 0.0f;
+	auto exit = 1.0f;
+
+	for (int axis = 0; axis < 2; ++axis)
+	{
+		if (std::abs(direction[axis]) < Util::EPSILON)
+		{
+			// parallel to this slab - 0 * infinity would give NaN, so just check the segment lies inside it
+			if (start_point[axis] < aabb.lowerBound[axis] || start_point[axis] > aabb.upperBound[axis])
+			{
+				return false;
+			}
+			continue;
+		}
+
+		const auto t1 = (aabb.lowerBound[axis] - start_point[axis]) * inverse_direction[axis];
+		const auto t2 = (aabb.upperBound[axis] - start_point[axis]) * inverse_direction[axis];
+		entry = std::max(entry, std::min(t1, t2));
+		exit = std::min(exit, std::max(t1, t2));
+		if (entry > exit)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,150 @@
+#pragma once
+#ifndef __AABB_TREE__
+#define __AABB_TREE__
+
+#include <cmath>
+#include <vector>
+#include "AABB.h"
+#include "DisplayObject.h"
+#include "Util.h"
+
+/*
+ * Dynamic bounding volume hierarchy for static obstacles and moving agents.
+ * Leaves store a fattened AABB so small movements do not touch the tree, and
+ * insertions and removals keep the tree balanced with rotations, giving O(log n)
+ * updates and queries.
+ */
+class AABBTree
+{
+public:
+	static const int NULL_NODE = -1;
+	static constexpr float FAT_MARGIN = 8.0f; // pixels added on each side of a leaf
+
+	AABBTree();
+	~AABBTree();
+
+	// proxy management - returns the id used by the other functions
+	int createProxy(DisplayObject* object);
+	void destroyProxy(int proxy_id);
+	// re-inserts the proxy only when it has left its fattened bounds
+	bool moveProxy(int proxy_id);
+	void clear();
+
+	DisplayObject* getObject(int proxy_id) const;
+	const AABB& getFatAABB(int proxy_id) const;
+	int getHeight() const;
+
+	// tight bounds of a display object
+	static AABB computeAABB(GameObject* object);
+
+	/*
+	 * Calls callback(proxy_id) for every proxy whose fattened bounds overlap aabb.
+	 * Return false from the callback to stop the query.
+	 */
+	template <typename T>
+	void query(const AABB& aabb, T callback) const;
+
+	/*
+	 * Calls callback(proxy_id) for every proxy whose fattened bounds the segment crosses.
+	 * Return false from the callback to stop the raycast.
+	 */
+	template <typename T>
+	void raycast(glm::vec2 start_point, glm::vec2 end_point, T callback) const;
+
+private:
+	struct TreeNode
+	{
+		AABB aabb;
+		DisplayObject* object;
+		int parent; // doubles as the next free node while on the free list
+		int child1;
+		int child2;
+		int height; // leaf = 0, free node = -1
+
+		bool isLeaf() const { return child1 == NULL_NODE; }
+	};
+
+	std::vector<TreeNode> m_nodes;
+	int m_root;
+	int m_freeList;
+
+	// traversal stack shared by query and raycast so they don't allocate once it has grown.
+	// each traversal works above the entries it found, so a callback can start another traversal
+	mutable std::vector<int> m_stack;
+
+	int m_allocateNode();
+	void m_freeNode(int node_id);
+	void m_insertLeaf(int leaf);
+	void m_removeLeaf(int leaf);
+	int m_balance(int node_id);
+
+	static bool m_segmentOverlaps(glm::vec2 start_point, glm::vec2 direction, glm::vec2 inverse_direction, const AABB& aabb);
+};
+
+template <typename T>
+void AABBTree::query(const AABB& aabb, T callback) const
+{
+	if (m_root == NULL_NODE) return;
+
+	const auto base = m_stack.size();
+	m_stack.push_back(m_root);
+
+	while (m_stack.size() > base)
+	{
+		const auto& node = m_nodes[m_stack.back()];
+		m_stack.pop_back();
+		if (!node.aabb.overlaps(aabb)) continue;
+
+		if (node.isLeaf())
+		{
+			if (!callback(static_cast<int>(&node - m_nodes.data())))
+			{
+				m_stack.resize(base);
+				return;
+			}
+		}
+		else
+		{
+			m_stack.push_back(node.child1);
+			m_stack.push_back(node.child2);
+		}
+	}
+}
+
+template <typename T>
+void AABBTree::raycast(const glm::vec2 start_point, const glm::vec2 end_point, T callback) const
+{
+	if (m_root == NULL_NODE) return;
+
+	// axes the segment runs parallel to are tested without the inverse, see m_segmentOverlaps
+	const auto direction = end_point - start_point;
+	const auto inverse_direction = glm::vec2(
+		(std::abs(direction.x) < Util::EPSILON) ? 0.0f : 1.0f / direction.x,
+		(std::abs(direction.y) < Util::EPSILON) ? 0.0f : 1.0f / direction.y);
+
+	const auto base = m_stack.size();
+	m_stack.push_back(m_root);
+
+	while (m_stack.size() > base)
+	{
+		const auto& node = m_nodes[m_stack.back()];
+		m_stack.pop_back();
+		if (!m_segmentOverlaps(start_point, direction, inverse_direction, node.aabb)) continue;
+
+		if (node.isLeaf())
+		{
+			if (!callback(static_cast<int>(&node - m_nodes.data())))
+			{
+				m_stack.resize(base);
+				return;
+			}
+		}
+		else
+		{
+			m_stack.push_back(node.child1);
+			m_stack.push_back(node.child2);
+		}
+	}
+}
+
+#endif /* defined (__AABB_TREE__) */
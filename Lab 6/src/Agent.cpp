@@ -1,7 +1,9 @@
 #include "Agent.h"
 
+#include <cmath>
 #include <iostream>
 
+#include "CollisionManager.h"
 #include "Util.h"
 
 Agent::Agent()
@@ -21,6 +23,8 @@ Agent::Agent()
 
 	// initialize the LOS distance
 	m_LOSDistance = 300; // 300px
+
+	m_pSpatialIndex = nullptr;
 }
 
 Agent::~Agent()
@@ -111,6 +115,35 @@ void Agent::setWhiskerAngle(const float angle)
 	m_whiskerAngle = angle;
 }
 
+const AABBTree* Agent::getSpatialIndex() const
+{
+	return m_pSpatialIndex;
+}
+
+void Agent::setSpatialIndex(const AABBTree* tree)
+{
+	m_pSpatialIndex = tree;
+}
+
+void Agent::sweepMove(const glm::vec2 displacement)
+{
+	if (m_pSpatialIndex == nullptr)
+	{
+		getTransform()->position += displacement;
+		return;
+	}
+
+	glm::vec2 contact_normal;
+	getTransform()->position += CollisionManager::sweepAndSlide(this, displacement, *m_pSpatialIndex, contact_normal);
+
+	// drop the part of the velocity that pushes into the contact face
+	const auto approach_speed = Util::dot(getRigidBody()->velocity, contact_normal);
+	if (approach_speed < 0.0f)
+	{
+		getRigidBody()->velocity -= contact_normal * approach_speed;
+	}
+}
+
 void Agent::updateWhiskers(const float angle)
 {
 	m_whiskerAngle = angle;
@@ -158,6 +191,7 @@ void Agent::setHasLOS(const bool state, const glm::vec4 colour)
 void Agent::setCurrentHeading(const float heading)
 {
 	m_currentHeading = heading;
+	setOrientation(heading);
 	m_changeDirection();
 }
 
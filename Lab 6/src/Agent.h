@@ -5,6 +5,8 @@
 #include <glm/vec4.hpp>
 #include "NavigationObject.h"
 
+class AABBTree;
+
 class Agent : public NavigationObject
 {
 public:
@@ -30,6 +32,7 @@ public:
 	bool* getCollisionWhiskers(); // returns the entire array
 	glm::vec4 getLineColour(int index);
 	float getWhiskerAngle() const;
+	const AABBTree* getSpatialIndex() const;
 
 	// setters (mutators)
 	void setTargetPosition(glm::vec2 new_position);
@@ -45,9 +48,11 @@ public:
 	void setRightLOSEndPoint(glm::vec2 point);
 	void setLineColour(int index, glm::vec4 colour);
 	void setWhiskerAngle(float angle);
+	void setSpatialIndex(const AABBTree* tree);
 
 	// public functions
 	void updateWhiskers(float angle);
+	void sweepMove(glm::vec2 displacement); // moves without tunnelling through obstacles in the spatial index
 
 private:
 	void m_changeDirection();
@@ -69,6 +74,9 @@ private:
 
 	float m_whiskerAngle; // angle of the left and right whiskers relative to the heading
 
+	// obstacles to sweep against when moving
+	const AABBTree* m_pSpatialIndex;
+
 };
 
 
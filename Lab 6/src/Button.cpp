@@ -18,9 +18,9 @@ Button::Button(const std::string& image_path, std::string button_name, const Gam
                const glm::vec2 position, const bool is_centered):
 m_alpha(255), m_name(std::move(button_name)), m_isCentered(is_centered), m_active(true)
 {
-	TextureManager::Instance().load(image_path,m_name);
+	m_textureHandle = TextureManager::Instance().load(image_path,m_name);
 
-	const auto size = TextureManager::Instance().getTextureSize(m_name);
+	const auto size = TextureManager::Instance().getTextureSize(m_textureHandle);
 	setWidth(size.x);
 	setHeight(size.y);
 	getTransform()->position = position;
@@ -37,7 +37,7 @@ void Button::draw()
 	const auto y = getTransform()->position.y;
 
 	// draw the button
-	TextureManager::Instance().draw(m_name, x, y, 0, m_alpha, m_isCentered);
+	TextureManager::Instance().draw(m_textureHandle, x, y, 0, m_alpha, m_isCentered);
 }
 
 void Button::update()
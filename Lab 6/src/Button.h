@@ -5,6 +5,7 @@
 #include "DisplayObject.h"
 #include <SDL.h>
 #include "UIControl.h"
+#include "TextureHandle.h"
 
 class Button : public UIControl
 {
@@ -28,6 +29,7 @@ public:
 private:
 	Uint8 m_alpha;
 	std::string m_name;
+	TextureHandle m_textureHandle;
 	bool m_isCentered;
 	bool m_active;
 };
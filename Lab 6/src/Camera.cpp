@@ -0,0 +1,70 @@
+#include "Camera.h"
+
+#include <algorithm>
+#include "Config.h"
+
+Camera::Camera()
+	: m_position(Config::SCREEN_WIDTH * 0.5f, Config::SCREEN_HEIGHT * 0.5f),
+	m_viewportSize(Config::SCREEN_WIDTH, Config::SCREEN_HEIGHT), m_zoom(1.0f)
+{
+}
+
+Camera::~Camera()
+= default;
+
+glm::vec2 Camera::getPosition() const
+{
+	return m_position;
+}
+
+void Camera::setPosition(const glm::vec2 position)
+{
+	m_position = position;
+}
+
+void Camera::move(const glm::vec2 offset)
+{
+	m_position += offset;
+}
+
+float Camera::getZoom() const
+{
+	return m_zoom;
+}
+
+void Camera::setZoom(const float zoom)
+{
+	// a zero or negative zoom would flip or collapse the view
+	m_zoom = std::max(zoom, 0.01f);
+}
+
+glm::vec2 Camera::getViewportSize() const
+{
+	return m_viewportSize;
+}
+
+void Camera::setViewportSize(const glm::vec2 size)
+{
+	m_viewportSize = size;
+}
+
+glm::vec2 Camera::worldToScreen(const glm::vec2 world_point) const
+{
+	return (world_point - m_position) * m_zoom + m_viewportSize * 0.5f;
+}
+
+glm::vec2 Camera::screenToWorld(const glm::vec2 screen_point) const
+{
+	return (screen_point - m_viewportSize * 0.5f) / m_zoom + m_position;
+}
+
+AABB Camera::getViewBounds() const
+{
+	const auto half_extents = m_viewportSize * 0.5f / m_zoom;
+	return { m_position - half_extents, m_position + half_extents };
+}
+
+bool Camera::isVisible(const AABB& bounds) const
+{
+	return getViewBounds().overlaps(bounds);
+}
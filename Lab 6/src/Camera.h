@@ -0,0 +1,42 @@
+#pragma once
+#ifndef __CAMERA__
+#define __CAMERA__
+
+#include <glm/vec2.hpp>
+#include "AABB.h"
+
+/*
+ * Maps world space to the window. position is the world point shown at the centre of the
+ * viewport and zoom scales the world around it. The default camera is centred on the window,
+ * so world and screen coordinates match until the camera is moved.
+ */
+class Camera
+{
+public:
+	Camera();
+	~Camera();
+
+	glm::vec2 getPosition() const;
+	void setPosition(glm::vec2 position);
+	void move(glm::vec2 offset);
+
+	float getZoom() const;
+	void setZoom(float zoom);
+
+	glm::vec2 getViewportSize() const;
+	void setViewportSize(glm::vec2 size);
+
+	glm::vec2 worldToScreen(glm::vec2 world_point) const;
+	glm::vec2 screenToWorld(glm::vec2 screen_point) const;
+
+	// the world space rectangle the viewport currently shows
+	AABB getViewBounds() const;
+	bool isVisible(const AABB& bounds) const;
+
+private:
+	glm::vec2 m_position;
+	glm::vec2 m_viewportSize;
+	float m_zoom;
+};
+
+#endif /* defined (__CAMERA__) */
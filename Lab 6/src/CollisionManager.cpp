@@ -4,103 +4,39 @@
 
 
 
-int CollisionManager::squaredDistance(const glm::vec2 p1, const glm::vec2 p2)
+float CollisionManager::squaredDistance(const glm::vec2 p1, const glm::vec2 p2)
 {
-	const int diffOfXs = p2.x - p1.x;
-	const int diffOfYs = p2.y - p1.y;
-	const auto result = diffOfXs * diffOfXs + diffOfYs * diffOfYs;
-
-	return result;
+	const auto diffOfXs = p2.x - p1.x;
+	const auto diffOfYs = p2.y - p1.y;
+	return diffOfXs * diffOfXs + diffOfYs * diffOfYs;
 }
 
-bool CollisionManager::squaredRadiusCheck(GameObject* object1, GameObject* object2)
+// plain branch free loop over contiguous input so the compiler can vectorise it
+void CollisionManager::squaredDistances(const glm::vec2 point, const glm::vec2* points, const int count, float* squared_distances)
 {
-	glm::vec2 P1 = object1->getTransform()->position;
-	glm::vec2 P2 = object2->getTransform()->position;
-	const int halfHeights = (object1->getHeight() + object2->getHeight()) * 0.5f;
-
-	if (CollisionManager::squaredDistance(P1, P2) < (halfHeights * halfHeights)) {
-		if (!object1->getRigidBody()->isColliding) {
-
-			object1->getRigidBody()->isColliding = true;
-
-			switch (object2->getType()) {
-			case TARGET:
-				std::cout << "Collision with Target!" << std::endl;
-				SoundManager::Instance().playSound("yay", 0);
-				break;
-			default:
-
-				break;
-			}
-
-			return true;
-		}
-		return false;
-	}
-	else
+	for (auto i = 0; i < count; ++i)
 	{
-		object1->getRigidBody()->isColliding = false;
-		return false;
+		const auto dx = points[i].x - point.x;
+		const auto dy = points[i].y - point.y;
+		squared_distances[i] = dx * dx + dy * dy;
 	}
 }
 
-bool CollisionManager::AABBCheck(GameObject* object1, GameObject* object2)
+bool CollisionManager::squaredRadiusCheck(const GameObject* object1, const GameObject* object2)
 {
-	// prepare relevant variables
-	 auto p1 = object1->getTransform()->position;
-	 auto p2 = object2->getTransform()->position;
-	const float p1Width = object1->getWidth();
-	const float p1Height = object1->getHeight();
-	const float p2Width = object2->getWidth();
-	const float p2Height = object2->getHeight();
-
-	if (object1->isCentered())
-	{
-		p1 += glm::vec2(-p1Width * 0.5f, -p1Height * 0.5f);
-	}
-
-	if (object2->isCentered())
-	{
-		p2 += glm::vec2(-p2Width * 0.5f, -p2Height * 0.5f);
-	}
-
-	if (
-		p1.x < p2.x + p2Width &&
-		p1.x + p1Width > p2.x &&
-		p1.y < p2.y + p2Height &&
-		p1.y + p1Height > p2.y
-		)
-	{
-		if (!object1->getRigidBody()->isColliding) 
-		{
-			object1->getRigidBody()->isColliding = true;
-
-			switch (object2->getType())
-			{
-				case AGENT:
-					std::cout << "Collision with SpaceShip!" << std::endl;
-					SoundManager::Instance().playSound("boom", 0);
-					break;
-				default:
-
-					break;
-			}
+	const glm::vec2 P1 = object1->getTransform()->position;
+	const glm::vec2 P2 = object2->getTransform()->position;
+	const auto halfHeights = (object1->getHeight() + object2->getHeight()) * 0.5f;
 
-			return true;
-		}
-		return false;
-	}
-	else
-	{
-		object1->getRigidBody()->isColliding = false;
-		return false;
-	}
+	return CollisionManager::squaredDistance(P1, P2) < (halfHeights * halfHeights);
+}
 
-	return false;
+bool CollisionManager::AABBCheck(const GameObject* object1, const GameObject* object2)
+{
+	return AABBCheckWithBuffer(object1, object2, 0);
 }
 
-bool CollisionManager::AABBCheckWithBuffer(GameObject* object1, GameObject* object2, const int buffer)
+bool CollisionManager::AABBCheckWithBuffer(const GameObject* object1, const GameObject* object2, const int buffer)
 {
 	// prepare relevant variables
 	auto p1 = object1->getTransform()->position;
@@ -126,39 +62,77 @@ bool CollisionManager::AABBCheckWithBuffer(GameObject* object1, GameObject* obje
 	p2Width += buffer;
 	p2Height += buffer;
 
-	if (
+	return
 		p1.x < p2.x + p2Width &&
 		p1.x + p1Width > p2.x &&
 		p1.y < p2.y + p2Height &&
-		p1.y + p1Height > p2.y
-		)
+		p1.y + p1Height > p2.y;
+}
+
+bool CollisionManager::OBBCheck(const OBB& box1, const OBB& box2)
+{
+	const auto centre_offset = box2.centre - box1.centre;
+	const glm::vec2 axes[4] = { box1.axes[0], box1.axes[1], box2.axes[0], box2.axes[1] };
+
+	// the boxes are separated if their projections do not overlap on any of the four face axes
+	for (const auto axis : axes)
 	{
-		if (!object1->getRigidBody()->isColliding)
+		const auto radius1 = box1.halfExtents.x * std::abs(Util::dot(box1.axes[0], axis)) + box1.halfExtents.y * std::abs(Util::dot(box1.axes[1], axis));
+		const auto radius2 = box2.halfExtents.x * std::abs(Util::dot(box2.axes[0], axis)) + box2.halfExtents.y * std::abs(Util::dot(box2.axes[1], axis));
+		if (std::abs(Util::dot(centre_offset, axis)) > radius1 + radius2)
 		{
-			object1->getRigidBody()->isColliding = true;
-
-			switch (object2->getType())
-			{
-			case AGENT:
-				std::cout << "Collision with SpaceShip!" << std::endl;
-				SoundManager::Instance().playSound("boom", 0);
-				break;
-			default:
+			return false;
+		}
+	}
 
-				break;
-			}
+	return true;
+}
 
-			return true;
-		}
+bool CollisionManager::OBBAABBCheck(const OBB& box1, const AABB& box2)
+{
+	// world axes first - they are the cheap ones
+	const auto obb_bounds = box1.getAABB();
+	if (!obb_bounds.overlaps(box2))
+	{
 		return false;
 	}
-	else
+
+	// then the two box axes
+	const auto aabb_centre = (box2.lowerBound + box2.upperBound) * 0.5f;
+	const auto aabb_half_extents = (box2.upperBound - box2.lowerBound) * 0.5f;
+	const auto centre_offset = aabb_centre - box1.centre;
+	for (auto i = 0; i < 2; ++i)
 	{
-		object1->getRigidBody()->isColliding = false;
-		return false;
+		const auto axis = box1.axes[i];
+		const auto radius1 = box1.halfExtents[i];
+		const auto radius2 = aabb_half_extents.x * std::abs(axis.x) + aabb_half_extents.y * std::abs(axis.y);
+		if (std::abs(Util::dot(centre_offset, axis)) > radius1 + radius2)
+		{
+			return false;
+		}
 	}
 
-	return false;
+	return true;
+}
+
+bool CollisionManager::shapeCheck(const GameObject* object1, const GameObject* object2)
+{
+	const auto oriented1 = object1->getCollisionShape() == ORIENTED_RECTANGLE;
+	const auto oriented2 = object2->getCollisionShape() == ORIENTED_RECTANGLE;
+
+	if (oriented1 && oriented2)
+	{
+		return OBBCheck(object1->getOBB(), object2->getOBB());
+	}
+	if (oriented1)
+	{
+		return OBBAABBCheck(object1->getOBB(), object2->getBounds());
+	}
+	if (oriented2)
+	{
+		return OBBAABBCheck(object2->getOBB(), object1->getBounds());
+	}
+	return AABBCheck(object1, object2);
 }
 
 bool CollisionManager::lineLineCheck(const glm::vec2 line1_start, const glm::vec2 line1_end, const glm::vec2 line2_start, const glm::vec2 line2_end)
@@ -187,29 +161,59 @@ bool CollisionManager::lineLineCheck(const glm::vec2 line1_start, const glm::vec
 
 bool CollisionManager::lineRectCheck(const glm::vec2 line_start, const glm::vec2 line_end, const glm::vec2 rect_start, const float rect_width, const float rect_height)
 {
-	const auto x1 = line_start.x;
-	const auto x2 = line_end.x;
-	const auto y1 = line_start.y;
-	const auto y2 = line_end.y;
-	const auto rx = rect_start.x;
-	const auto ry = rect_start.y;
-	const auto rw = rect_width;
-	const auto rh = rect_height;
+	float t;
+	glm::vec2 normal;
+	return segmentAABBCheck(line_start, line_end, rect_start, rect_start + glm::vec2(rect_width, rect_height), t, normal);
+}
 
-	// check if the line has hit any of the rectangle's sides
-	// uses the Line/Line function below
-	const auto left = lineLineCheck(glm::vec2(x1, y1), glm::vec2(x2, y2), glm::vec2(rx, ry), glm::vec2(rx, ry + rh));
-	const auto right = lineLineCheck(glm::vec2(x1, y1), glm::vec2(x2, y2), glm::vec2(rx + rw, ry), glm::vec2(rx + rw, ry + rh));
-	const auto top = lineLineCheck(glm::vec2(x1, y1), glm::vec2(x2, y2), glm::vec2(rx, ry), glm::vec2(rx + rw, ry));
-	const auto bottom = lineLineCheck(glm::vec2(x1, y1), glm::vec2(x2, y2), glm::vec2(rx, ry + rh), glm::vec2(rx + rw, ry + rh));
+/**
+ * Liang-Barsky / slab test - clips the segment's parameter range [0, 1] against the x and y slabs of the box.
+ * On a hit, t is the entry parameter along the segment and normal is the face that was entered.
+ * A segment that starts inside the box hits at t = 0 with a zero normal.
+ */
+bool CollisionManager::segmentAABBCheck(const glm::vec2 line_start, const glm::vec2 line_end, const glm::vec2 box_min, const glm::vec2 box_max, float& t, glm::vec2& normal)
+{
+	const auto direction = line_end - line_start;
+	auto t_enter = 0.0f;
+	auto t_exit = 1.0f;
+	normal = glm::vec2(0.0f, 0.0f);
 
-	// if ANY of the above are true, the line
-	// has hit the rectangle
-	if (left || right || top || bottom) {
-		return true;
+	for (int axis = 0; axis < 2; ++axis)
+	{
+		if (std::abs(direction[axis]) < Util::EPSILON)
+		{
+			// parallel to this slab - reject if the segment lies outside it
+			if (line_start[axis] < box_min[axis] || line_start[axis] > box_max[axis])
+			{
+				return false;
+			}
+			continue;
+		}
+
+		const auto inverse = 1.0f / direction[axis];
+		auto t_near = (box_min[axis] - line_start[axis]) * inverse;
+		auto t_far = (box_max[axis] - line_start[axis]) * inverse;
+		if (t_near > t_far)
+		{
+			std::swap(t_near, t_far);
+		}
+
+		if (t_near > t_enter)
+		{
+			t_enter = t_near;
+			normal = glm::vec2(0.0f, 0.0f);
+			normal[axis] = -Util::sign(direction[axis]);
+		}
+		t_exit = std::min(t_exit, t_far);
+
+		if (t_enter > t_exit)
+		{
+			return false;
+		}
 	}
 
-	return false;
+	t = t_enter;
+	return true;
 }
 
 bool CollisionManager::lineRectEdgeCheck(const glm::vec2 line_start, const glm::vec2 rect_start, const float rect_width, const float rect_height)
@@ -260,7 +264,7 @@ bool CollisionManager::lineRectEdgeCheck(const glm::vec2 line_start, const glm::
 	return state;
 }
 
-int CollisionManager::minSquaredDistanceLineLine(glm::vec2 line1_start, glm::vec2 line1_end, glm::vec2 line2_start, glm::vec2 line2_end)
+float CollisionManager::minSquaredDistanceLineLine(glm::vec2 line1_start, glm::vec2 line1_end, glm::vec2 line2_start, glm::vec2 line2_end)
 {
 	auto u = line1_end - line1_start;
 	auto v = line2_end - line2_start;
@@ -301,26 +305,10 @@ bool CollisionManager::lineAABBCheck(Ship* object1, GameObject* object2)
 	const int halfBoxHeight = boxHeight * 0.5f;
 	const auto boxStart = object2->getTransform()->position - glm::vec2(halfBoxWidth, halfBoxHeight);
 
-	if (lineRectCheck(lineStart, lineEnd, boxStart, boxWidth, boxHeight))
-	{
-		switch (object2->getType()) {
-		case TARGET:
-			std::cout << "Collision with Obstacle!" << std::endl;
-			SoundManager::Instance().playSound("yay", 0);
-
-			break;
-		default:
-
-			break;
-		}
-
-		return true;
-	}
-
-	return false;
+	return lineRectCheck(lineStart, lineEnd, boxStart, boxWidth, boxHeight);
 }
 
-int CollisionManager::circleAABBsquaredDistance(const glm::vec2 circle_centre, int circle_radius, const glm::vec2 box_start, const int box_width, const int box_height)
+float CollisionManager::circleAABBsquaredDistance(const glm::vec2 circle_centre, float circle_radius, const glm::vec2 box_start, const float box_width, const float box_height)
 {
 	auto dx = std::max(box_start.x - circle_centre.x, 0.0f);
 	dx = std::max(dx, circle_centre.x - (box_start.x + box_width));
@@ -330,52 +318,18 @@ int CollisionManager::circleAABBsquaredDistance(const glm::vec2 circle_centre, i
 	return (dx * dx) + (dy * dy);
 }
 
-bool CollisionManager::circleAABBCheck(GameObject* object1, GameObject* object2)
+bool CollisionManager::circleAABBCheck(const GameObject* object1, const GameObject* object2)
 {
 	// circle
 	const auto circleCentre = object1->getTransform()->position;
-	const int circleRadius = std::max(object1->getWidth() * 0.5f, object1->getHeight() * 0.5f);
+	const auto circleRadius = std::max(object1->getWidth() * 0.5f, object1->getHeight() * 0.5f);
 	// aabb
 	const auto boxWidth = object2->getWidth();
-	int halfBoxWidth = boxWidth * 0.5f;
 	const auto boxHeight = object2->getHeight();
-	int halfBoxHeight = boxHeight * 0.5f;
 
 	const auto boxStart = object2->getTransform()->position - glm::vec2(boxWidth * 0.5f, boxHeight * 0.5f);
 
-	if (circleAABBsquaredDistance(circleCentre, circleRadius, boxStart, boxWidth, boxHeight) <= (circleRadius * circleRadius))
-	{
-		if (!object1->getRigidBody()->isColliding) 
-		{
-
-			object1->getRigidBody()->isColliding = true;
-
-			switch (object2->getType())
-			{
-			case AGENT:
-				{
-					std::cout << "Collision with SpaceShip!" << std::endl;
-					SoundManager::Instance().playSound("yay", 0);
-				}
-
-
-				break;
-				default:
-
-					break;
-			}
-
-			return true;
-		}
-		return false;
-	}
-	else
-	{
-		object1->getRigidBody()->isColliding = false;
-		return false;
-	}
-
-	return false;
+	return circleAABBsquaredDistance(circleCentre, circleRadius, boxStart, boxWidth, boxHeight) <= (circleRadius * circleRadius);
 }
 
 bool CollisionManager::pointRectCheck(const glm::vec2 point, const glm::vec2 rect_start, const float rect_width, const float rect_height)
@@ -396,10 +350,13 @@ bool CollisionManager::pointRectCheck(const glm::vec2 point, const glm::vec2 rec
 }
 
 // assumptions - the list of objects are stored so that they are facing the target and the target is loaded last
-bool CollisionManager::LOSCheck(Agent* agent, glm::vec2 end_point, const std::vector<DisplayObject*>& objects, DisplayObject* target)
+bool CollisionManager::LOSCheck(Agent* agent, const glm::vec2 end_point, const std::vector<DisplayObject*>& objects, DisplayObject* target)
 {
-	const auto start_point = agent->getTransform()->position;
+	return LOSCheck(agent->getTransform()->position, end_point, objects, target);
+}
 
+bool CollisionManager::LOSCheck(const glm::vec2 start_point, const glm::vec2 end_point, const std::vector<DisplayObject*>& objects, DisplayObject* target)
+{
 	// Check collision with obstacles first.
 		for (auto object : objects)
 		{
@@ -421,73 +378,275 @@ bool CollisionManager::LOSCheck(Agent* agent, glm::vec2 end_point, const std::ve
 	return false;
 }
 
-void CollisionManager::rotateAABB(GameObject* object1, const float angle)
+// only the objects whose bounds the LOS segment crosses are tested
+bool CollisionManager::LOSCheck(const glm::vec2 start_point, const glm::vec2 end_point, const AABBTree& tree, DisplayObject* target)
 {
-	// create an array of vec2s using right winding order (TL, TR, BR, BL)
-	glm::vec2 points[4];
-	
-	const glm::vec2 position = object1->getTransform()->position;
-	
-	const auto width = object1->getRigidBody()->bounds.x;
-	const float half_width = width * 0.5f;
-	const auto height = object1->getRigidBody()->bounds.y;
-	const float half_height = height * 0.5f;
-	
-	// check if object1 is centered
-	if (object1->isCentered())
+	const auto startToTargetSquaredDistance = Util::getClosestEdgeSquared(start_point, target);
+
+	// Check collision with obstacles first.
+	auto blocked = false;
+	tree.raycast(start_point, end_point, [&](const int proxy_id)
 	{
-		// compute points
-		points[0] = glm::vec2(position.x - half_width, position.y - half_height);
-		points[1] = glm::vec2(position.x + half_width, position.y - half_height);
-		points[2] = glm::vec2(position.x + half_width, position.y + half_height);
-		points[3] = glm::vec2(position.x - half_width, position.y + half_height);
+		const auto object = tree.getObject(proxy_id);
+
+		// agents, path nodes and the target never block LOS
+		const auto type = object->getType();
+		if (type == AGENT || type == PATH_NODE || type == TARGET) return true;
+
+		// ignore anything further away than the target
+		if (Util::getClosestEdgeSquared(start_point, object) > startToTargetSquaredDistance) return true;
+
+		auto objectOffset = glm::vec2(object->getWidth() * 0.5f, object->getHeight() * 0.5f);
+		blocked = lineRectCheck(start_point, end_point, object->getTransform()->position - objectOffset,
+			object->getWidth(), object->getHeight());
+		return !blocked;
+	});
+
+	if (blocked)
+	{
+		return false;
 	}
-	else
+
+	// Now check if hitting target.
+	auto targetOffset = glm::vec2(target->getWidth() * 0.5f, target->getHeight() * 0.5f);
+	return lineRectCheck(start_point, end_point, target->getTransform()->position - targetOffset,
+		target->getWidth(), target->getHeight());
+}
+
+// sets the agent's collision whisker flags from the obstacles in the spatial index
+void CollisionManager::whiskerCheck(Agent* agent, const AABBTree& tree)
+{
+	const auto start_point = agent->getTransform()->position;
+	const glm::vec2 end_points[3] = { agent->getLeftLOSEndPoint(), agent->getMiddleLOSEndPoint(), agent->getRightLOSEndPoint() };
+
+	for (int i = 0; i < 3; ++i)
 	{
-		// compute points
-		points[0] = glm::vec2(position.x, position.y);
-		points[1] = glm::vec2(position.x + width, position.y);
-		points[2] = glm::vec2(position.x + width, position.y + height);
-		points[3] = glm::vec2(position.x, position.y + height);
+		auto colliding = false;
+		tree.raycast(start_point, end_points[i], [&](const int proxy_id)
+		{
+			const auto object = tree.getObject(proxy_id);
+			if (object->getType() != OBSTACLE) return true;
+
+			const auto box = AABBTree::computeAABB(object);
+			float t;
+			glm::vec2 normal;
+			colliding = segmentAABBCheck(start_point, end_points[i], box.lowerBound, box.upperBound, t, normal);
+			return !colliding;
+		});
+		agent->getCollisionWhiskers()[i] = colliding;
 	}
+}
+
+/**
+ * Swept box vs box - the target is grown by the moving box's half extents (Minkowski sum)
+ * so the sweep reduces to a segment traced from the moving box's centre.
+ */
+bool CollisionManager::sweptAABBCheck(const AABB& moving_box, const glm::vec2 displacement, const AABB& target_box, float& t, glm::vec2& normal)
+{
+	const auto half_extents = (moving_box.upperBound - moving_box.lowerBound) * 0.5f;
+	const auto centre = moving_box.lowerBound + half_extents;
 
-	// rotate each point by the desired angle
-	for (int i = 0; i < 4; ++i)
+	return segmentAABBCheck(centre, centre + displacement, target_box.lowerBound - half_extents, target_box.upperBound + half_extents, t, normal);
+}
+
+/**
+ * Swept circle vs box - the target is grown by the radius into a rounded box. The segment is traced against
+ * the square cornered box first and, if it enters through a corner, against the circle at that corner.
+ */
+bool CollisionManager::sweptCircleCheck(const glm::vec2 circle_centre, const float circle_radius, const glm::vec2 displacement, const AABB& target_box, float& t, glm::vec2& normal)
+{
+	const auto grow = glm::vec2(circle_radius, circle_radius);
+	if (!segmentAABBCheck(circle_centre, circle_centre + displacement, target_box.lowerBound - grow, target_box.upperBound + grow, t, normal))
 	{
-		points[i] = Util::rotatePoint(points[i], angle, position);
+		return false;
 	}
 
-	// initialize extents
-	auto top_left = glm::vec2(INFINITY, INFINITY);
-	auto bot_right = glm::vec2(-INFINITY, -INFINITY);
-	
-	// compute extents (top_left and bot_right)
-	for (const auto point : points)
+	// find which of the box's corner regions (if any) the entry point is in
+	const auto entry_point = circle_centre + displacement * t;
+	auto corner = entry_point;
+	auto outside_axes = 0;
+	for (int axis = 0; axis < 2; ++axis)
 	{
-		if(top_left.x > point.x)
+		if (entry_point[axis] < target_box.lowerBound[axis])
+		{
+			corner[axis] = target_box.lowerBound[axis];
+			++outside_axes;
+		}
+		else if (entry_point[axis] > target_box.upperBound[axis])
 		{
-			top_left.x = point.x;
+			corner[axis] = target_box.upperBound[axis];
+			++outside_axes;
 		}
+	}
 
-		if(top_left.y > point.y)
+	// face region (or already overlapping) - the grown box is exact here
+	if (outside_axes < 2)
+	{
+		return true;
+	}
+
+	// corner region - intersect the segment with the circle of radius circle_radius at the corner
+	const auto offset = circle_centre - corner;
+	const auto a = Util::dot(displacement, displacement);
+	const auto b = Util::dot(offset, displacement);
+	const auto c = Util::dot(offset, offset) - circle_radius * circle_radius;
+	const auto discriminant = b * b - a * c;
+	if (a < Util::EPSILON || discriminant < 0.0f || (c > 0.0f && b > 0.0f))
+	{
+		// parallel, missing the corner, or starting outside it and moving away
+		return false;
+	}
+
+	const auto time_of_impact = (-b - std::sqrt(discriminant)) / a;
+	if (time_of_impact > 1.0f)
+	{
+		return false;
+	}
+
+	t = std::max(time_of_impact, 0.0f);
+	normal = Util::normalize(circle_centre + displacement * t - corner);
+	return true;
+}
+
+/**
+ * Swept oriented box vs box - separating axis test over time on the two world axes and the two box axes.
+ * Each axis gives the interval of t in which the projections overlap, the boxes touch where all four
+ * intervals meet, and the axis that was entered last is the contact normal.
+ */
+bool CollisionManager::sweptOBBCheck(const OBB& moving_box, const glm::vec2 displacement, const AABB& target_box, float& t, glm::vec2& normal)
+{
+	const auto target_centre = (target_box.lowerBound + target_box.upperBound) * 0.5f;
+	const auto target_half_extents = (target_box.upperBound - target_box.lowerBound) * 0.5f;
+	const auto centre_offset = moving_box.centre - target_centre;
+	const glm::vec2 axes[4] = { glm::vec2(1.0f, 0.0f), glm::vec2(0.0f, 1.0f), moving_box.axes[0], moving_box.axes[1] };
+
+	auto t_enter = 0.0f;
+	auto t_exit = 1.0f;
+	normal = glm::vec2(0.0f, 0.0f);
+
+	for (const auto axis : axes)
+	{
+		const auto radius =
+			moving_box.halfExtents.x * std::abs(Util::dot(moving_box.axes[0], axis)) + moving_box.halfExtents.y * std::abs(Util::dot(moving_box.axes[1], axis)) +
+			target_half_extents.x * std::abs(axis.x) + target_half_extents.y * std::abs(axis.y);
+		const auto start = Util::dot(centre_offset, axis);
+		const auto speed = Util::dot(displacement, axis);
+
+		if (std::abs(speed) < Util::EPSILON)
 		{
-			top_left.y = point.y;
+			// not moving along this axis - reject if the projections are apart for the whole sweep
+			if (std::abs(start) > radius)
+			{
+				return false;
+			}
+			continue;
 		}
 
-		if(bot_right.x < point.x)
+		auto t_near = (-radius - start) / speed;
+		auto t_far = (radius - start) / speed;
+		if (t_near > t_far)
 		{
-			bot_right.x = point.x;
+			std::swap(t_near, t_far);
 		}
 
-		if(bot_right.y < point.y)
+		if (t_near > t_enter)
 		{
-			bot_right.y = point.y;
+			t_enter = t_near;
+			normal = axis * -Util::sign(speed);
 		}
+		t_exit = std::min(t_exit, t_far);
+
+		if (t_enter > t_exit)
+		{
+			return false;
+		}
+	}
+
+	t = t_enter;
+	return true;
+}
+
+/**
+ * Sweeps the collider along displacement, stops it at the earliest time of impact and slides
+ * the rest of the motion along the contact face with a second sweep. Obstacles the collider
+ * already overlaps are ignored so it can always move back out of them.
+ */
+glm::vec2 CollisionManager::sweepAndSlide(const GameObject* object, const glm::vec2 displacement, const AABBTree& tree, glm::vec2& contact_normal)
+{
+	// keeps the resolved position just off the contact face so the next frame does not start inside it
+	static constexpr float SKIN = 0.01f;
+
+	const auto is_circle = object->getCollisionShape() == CIRCLE;
+	const auto is_oriented = object->getCollisionShape() == ORIENTED_RECTANGLE;
+	const auto circle_radius = std::max(object->getWidth(), object->getHeight()) * 0.5f;
+
+	contact_normal = glm::vec2(0.0f, 0.0f);
+	// bounds only pick the candidates - an oriented collider is swept as its OBB, not the larger box around it
+	auto bounds = object->getBounds();
+	auto oriented_box = object->getOBB();
+	auto resolved = glm::vec2(0.0f, 0.0f);
+	auto remaining = displacement;
+
+	for (int pass = 0; pass < 2; ++pass)
+	{
+		if (Util::squaredMagnitude(remaining) < Util::EPSILON)
+		{
+			break;
+		}
+
+		// only obstacles inside the swept bounds can be hit
+		const auto moved_bounds = AABB{ bounds.lowerBound + remaining, bounds.upperBound + remaining };
+		auto first_t = 1.0f;
+		auto first_normal = glm::vec2(0.0f, 0.0f);
+
+		tree.query(AABB::combine(bounds, moved_bounds), [&](const int proxy_id)
+		{
+			const auto other = tree.getObject(proxy_id);
+			if (other == object || other->getType() != OBSTACLE) return true;
+
+			const auto target_box = AABBTree::computeAABB(other);
+			float t;
+			glm::vec2 normal;
+			auto hit = false;
+			if (is_circle)
+			{
+				hit = sweptCircleCheck((bounds.lowerBound + bounds.upperBound) * 0.5f, circle_radius, remaining, target_box, t, normal);
+			}
+			else if (is_oriented)
+			{
+				hit = sweptOBBCheck(oriented_box, remaining, target_box, t, normal);
+			}
+			else
+			{
+				hit = sweptAABBCheck(bounds, remaining, target_box, t, normal);
+			}
+
+			// a zero normal means we started inside the obstacle
+			if (hit && normal != glm::vec2(0.0f, 0.0f) && t < first_t)
+			{
+				first_t = t;
+				first_normal = normal;
+			}
+			return true;
+		});
+
+		if (first_normal == glm::vec2(0.0f, 0.0f))
+		{
+			resolved += remaining;
+			break;
+		}
+
+		// stop at the contact point, then slide whatever is left along the face
+		const auto step = remaining * first_t + first_normal * SKIN;
+		resolved += step;
+		bounds = AABB{ bounds.lowerBound + step, bounds.upperBound + step };
+		oriented_box.centre += step;
+		remaining *= 1.0f - first_t;
+		remaining -= first_normal * Util::dot(remaining, first_normal);
+		contact_normal = first_normal;
 	}
 
-	// compute new width and height values for object1
-	object1->setWidth(static_cast<int>(bot_right.x - top_left.x));
-	object1->setHeight(static_cast<int>(bot_right.y - top_left.y));
+	return resolved;
 }
 
 
@@ -7,35 +7,55 @@
 
 #include "GameObject.h"
 #include "ship.h"
-#include <GLM/gtx/norm.hpp>
+#include <glm/gtx/norm.hpp>
 #include "SoundManager.h"
+#include "AABBTree.h"
 
 class CollisionManager
 {
 public:
-	static int squaredDistance(glm::vec2 p1, glm::vec2 p2);
-	static bool squaredRadiusCheck(GameObject* object1, GameObject* object2);
+	// collision predicates are pure - they report overlap and never change the objects, play sounds or log.
+	// Use ContactTracker to turn overlaps into begin / stay / end events.
+	static float squaredDistance(glm::vec2 p1, glm::vec2 p2);
+	// batch version - writes one squared distance per point into squared_distances
+	static void squaredDistances(glm::vec2 point, const glm::vec2* points, int count, float* squared_distances);
+	static bool squaredRadiusCheck(const GameObject* object1, const GameObject* object2);
 
-	static bool AABBCheck(GameObject* object1, GameObject* object2);
-	static bool AABBCheckWithBuffer(GameObject* object1, GameObject* object2, int buffer);
+	static bool AABBCheck(const GameObject* object1, const GameObject* object2);
+	static bool AABBCheckWithBuffer(const GameObject* object1, const GameObject* object2, int buffer);
+
+	// separating axis tests for oriented boxes
+	static bool OBBCheck(const OBB& box1, const OBB& box2);
+	static bool OBBAABBCheck(const OBB& box1, const AABB& box2);
+	// picks the narrow phase test from each object's collision shape
+	static bool shapeCheck(const GameObject* object1, const GameObject* object2);
 
 	static bool lineLineCheck(glm::vec2 line1_start, glm::vec2 line1_end, glm::vec2 line2_start, glm::vec2 line2_end);
 
 	static bool lineRectCheck(glm::vec2 line_start, glm::vec2 line_end, glm::vec2 rect_start, float rect_width, float rect_height);
+	static bool segmentAABBCheck(glm::vec2 line_start, glm::vec2 line_end, glm::vec2 box_min, glm::vec2 box_max, float& t, glm::vec2& normal);
 	static bool lineRectEdgeCheck(glm::vec2 line_start, glm::vec2 rect_start, float rect_width, float rect_height);
 
 
-	static int minSquaredDistanceLineLine(glm::vec2 line1_start, glm::vec2 line1_end, glm::vec2 line2_start, glm::vec2 line2_end);
+	static float minSquaredDistanceLineLine(glm::vec2 line1_start, glm::vec2 line1_end, glm::vec2 line2_start, glm::vec2 line2_end);
 	static bool lineAABBCheck(Ship* object1, GameObject* object2);
 
-	static int circleAABBsquaredDistance(glm::vec2 circle_centre, int circle_radius, glm::vec2 box_start, int box_width, int box_height);
-	static bool circleAABBCheck(GameObject* object1, GameObject* object2);
+	static float circleAABBsquaredDistance(glm::vec2 circle_centre, float circle_radius, glm::vec2 box_start, float box_width, float box_height);
+	static bool circleAABBCheck(const GameObject* object1, const GameObject* object2);
 
 	static bool pointRectCheck(glm::vec2 point, glm::vec2 rect_start, float rect_width, float rect_height);
 
 	static bool LOSCheck(Agent* agent, glm::vec2 end_point, const std::vector<DisplayObject*>& objects, DisplayObject* target);
+	static bool LOSCheck(glm::vec2 start_point, glm::vec2 end_point, const std::vector<DisplayObject*>& objects, DisplayObject* target);
+	static bool LOSCheck(glm::vec2 start_point, glm::vec2 end_point, const AABBTree& tree, DisplayObject* target);
+	static void whiskerCheck(Agent* agent, const AABBTree& tree);
 
-	static void rotateAABB(GameObject* object1, float angle);
+	// continuous tests - t is the time of impact in [0, 1] along displacement, normal is the face that was hit
+	static bool sweptAABBCheck(const AABB& moving_box, glm::vec2 displacement, const AABB& target_box, float& t, glm::vec2& normal);
+	static bool sweptCircleCheck(glm::vec2 circle_centre, float circle_radius, glm::vec2 displacement, const AABB& target_box, float& t, glm::vec2& normal);
+	static bool sweptOBBCheck(const OBB& moving_box, glm::vec2 displacement, const AABB& target_box, float& t, glm::vec2& normal);
+	// moves object's collider along displacement against the obstacles in tree and returns the displacement it can make
+	static glm::vec2 sweepAndSlide(const GameObject* object, glm::vec2 displacement, const AABBTree& tree, glm::vec2& contact_normal);
 
 private:
 	CollisionManager();
@@ -8,7 +8,8 @@ enum CollisionShape
 	CIRCLE,
 	LINE,
 	CAPSULE,
-	RECTANGLE
+	RECTANGLE,
+	ORIENTED_RECTANGLE
 };
 
 #endif /* defined(__COLLISION_SHAPE__) */
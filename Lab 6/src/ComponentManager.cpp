@@ -0,0 +1,93 @@
+#include "ComponentManager.h"
+
+ComponentManager::ComponentManager()
+= default;
+
+ComponentManager::~ComponentManager()
+= default;
+
+int ComponentManager::createEntity(const Transform& transform, const RigidBody& rigid_body)
+{
+	int entity_id;
+	if (!m_freeEntityIds.empty())
+	{
+		entity_id = m_freeEntityIds.back();
+		m_freeEntityIds.pop_back();
+	}
+	else
+	{
+		entity_id = static_cast<int>(m_denseIndices.size());
+		m_denseIndices.push_back(-1);
+	}
+
+	m_denseIndices[entity_id] = static_cast<int>(m_transforms.size());
+	m_transforms.push_back(transform);
+	m_rigidBodies.push_back(rigid_body);
+	m_boundsOffsets.push_back({ glm::vec2(0.0f, 0.0f), glm::vec2(0.0f, 0.0f) });
+	m_bounds.push_back({ transform.position, transform.position });
+	m_entityIds.push_back(entity_id);
+
+	return entity_id;
+}
+
+void ComponentManager::destroyEntity(const int entity_id)
+{
+	const auto dense_index = m_denseIndices[entity_id];
+	const auto last_index = static_cast<int>(m_transforms.size()) - 1;
+
+	// keep the arrays packed by moving the last entity into the freed slot
+	if (dense_index != last_index)
+	{
+		m_transforms[dense_index] = m_transforms[last_index];
+		m_rigidBodies[dense_index] = m_rigidBodies[last_index];
+		m_boundsOffsets[dense_index] = m_boundsOffsets[last_index];
+		m_bounds[dense_index] = m_bounds[last_index];
+		m_entityIds[dense_index] = m_entityIds[last_index];
+		m_denseIndices[m_entityIds[dense_index]] = dense_index;
+	}
+
+	m_transforms.pop_back();
+	m_rigidBodies.pop_back();
+	m_boundsOffsets.pop_back();
+	m_bounds.pop_back();
+	m_entityIds.pop_back();
+
+	m_denseIndices[entity_id] = -1;
+	m_freeEntityIds.push_back(entity_id);
+}
+
+Transform& ComponentManager::getTransform(const int entity_id)
+{
+	return m_transforms[m_denseIndices[entity_id]];
+}
+
+RigidBody& ComponentManager::getRigidBody(const int entity_id)
+{
+	return m_rigidBodies[m_denseIndices[entity_id]];
+}
+
+void ComponentManager::setBoundsOffsets(const int entity_id, const AABB& offsets)
+{
+	m_boundsOffsets[m_denseIndices[entity_id]] = offsets;
+}
+
+void ComponentManager::updateBounds()
+{
+	const auto count = m_transforms.size();
+	for (size_t i = 0; i < count; ++i)
+	{
+		const auto position = m_transforms[i].position;
+		m_bounds[i].lowerBound = position + m_boundsOffsets[i].lowerBound;
+		m_bounds[i].upperBound = position + m_boundsOffsets[i].upperBound;
+	}
+}
+
+const AABB& ComponentManager::getBounds(const int entity_id) const
+{
+	return m_bounds[m_denseIndices[entity_id]];
+}
+
+int ComponentManager::numberOfEntities() const
+{
+	return static_cast<int>(m_entityIds.size());
+}
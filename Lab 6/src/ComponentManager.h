@@ -0,0 +1,56 @@
+#pragma once
+#ifndef __COMPONENT_MANAGER__
+#define __COMPONENT_MANAGER__
+
+#include <vector>
+#include "AABB.h"
+#include "Transform.h"
+#include "RigidBody.h"
+
+/* Singleton */
+/*
+ * Dense storage for the Transform and RigidBody components of objects that opt in with
+ * GameObject::useComponentManager(), plus the world bounds of their colliders. Each lives in
+ * a packed array, so updateBounds() and other whole-set passes walk contiguous memory.
+ * Entity ids stay valid for the object's lifetime - removal swaps the last entity into
+ * the freed slot, so references into the arrays must not be kept across create / destroy.
+ */
+class ComponentManager
+{
+public:
+	static ComponentManager& Instance()
+	{
+		static ComponentManager instance; // Magic statics.
+		return instance;
+	}
+
+	int createEntity(const Transform& transform, const RigidBody& rigid_body);
+	void destroyEntity(int entity_id);
+
+	Transform& getTransform(int entity_id);
+	RigidBody& getRigidBody(int entity_id);
+
+	// collider bounds relative to the position - set by the owner whenever its size, shape or orientation changes
+	void setBoundsOffsets(int entity_id, const AABB& offsets);
+	// rebuilds the world bounds of every entity from its position in one pass
+	void updateBounds();
+	// world bounds as of the last updateBounds()
+	const AABB& getBounds(int entity_id) const;
+
+	int numberOfEntities() const;
+
+private:
+	ComponentManager();
+	~ComponentManager();
+
+	std::vector<Transform> m_transforms;
+	std::vector<RigidBody> m_rigidBodies;
+	std::vector<AABB> m_boundsOffsets;
+	std::vector<AABB> m_bounds;
+	std::vector<int> m_entityIds; // dense index -> entity id
+
+	std::vector<int> m_denseIndices; // entity id -> dense index, -1 when free
+	std::vector<int> m_freeEntityIds;
+};
+
+#endif /* defined (__COMPONENT_MANAGER__) */
@@ -17,6 +17,10 @@ public:
 	static const int MINE_NUM = 50;
 	static const int SCORE = 0;
 	static const int LIVES = 5;
+	static const int ATLAS_PAGE_SIZE = 2048; // largest texture atlas page, clamped to what the renderer supports
+	static const int TILE_MAP_CHUNK_SIZE = 16; // tiles along each side of a baked tile map chunk
+	static const int TILE_MAP_CHUNK_CACHE = 32; // baked chunks a tile map layer keeps before the least recently drawn go
+	static const int TEXT_TEXTURE_BUDGET = 4 * 1024 * 1024; // bytes of unreferenced text textures kept before the oldest go
 
 	// Define Custom Deleters for shared_ptr types
 	static void SDL_DelRes(SDL_Window* r) { SDL_DestroyWindow(r); }
@@ -0,0 +1,22 @@
+#pragma once
+#ifndef __CONTACT_EVENT__
+#define __CONTACT_EVENT__
+
+class DisplayObject;
+
+enum ContactEventType
+{
+	CONTACT_BEGIN, // first frame the pair overlaps
+	CONTACT_STAY, // pair was already overlapping last frame
+	CONTACT_END, // pair stopped overlapping this frame
+	NUM_OF_CONTACT_EVENT_TYPES
+};
+
+struct ContactEvent
+{
+	ContactEventType type;
+	DisplayObject* first;
+	DisplayObject* second;
+};
+
+#endif /* defined (__CONTACT_EVENT__) */
@@ -0,0 +1,66 @@
+#include "ContactTracker.h"
+
+#include <algorithm>
+
+ContactTracker::ContactTracker()
+= default;
+
+ContactTracker::~ContactTracker()
+= default;
+
+void ContactTracker::addContact(DisplayObject* first, DisplayObject* second)
+{
+	// store each pair in one order so (a, b) and (b, a) match
+	if (second < first)
+	{
+		std::swap(first, second);
+	}
+	m_currentContacts.emplace_back(first, second);
+}
+
+void ContactTracker::update()
+{
+	m_events.clear();
+
+	std::sort(m_currentContacts.begin(), m_currentContacts.end());
+	m_currentContacts.erase(std::unique(m_currentContacts.begin(), m_currentContacts.end()), m_currentContacts.end());
+
+	// walk both sorted lists together
+	auto previous = m_previousContacts.begin();
+	auto current = m_currentContacts.begin();
+	while (previous != m_previousContacts.end() || current != m_currentContacts.end())
+	{
+		if (current == m_currentContacts.end() || (previous != m_previousContacts.end() && *previous < *current))
+		{
+			m_events.push_back({ CONTACT_END, previous->first, previous->second });
+			++previous;
+		}
+		else if (previous == m_previousContacts.end() || *current < *previous)
+		{
+			m_events.push_back({ CONTACT_BEGIN, current->first, current->second });
+			++current;
+		}
+		else
+		{
+			m_events.push_back({ CONTACT_STAY, current->first, current->second });
+			++previous;
+			++current;
+		}
+	}
+
+	// this frame's contacts become the baseline for the next frame
+	std::swap(m_previousContacts, m_currentContacts);
+	m_currentContacts.clear();
+}
+
+void ContactTracker::clear()
+{
+	m_previousContacts.clear();
+	m_currentContacts.clear();
+	m_events.clear();
+}
+
+const std::vector<ContactEvent>& ContactTracker::getEvents() const
+{
+	return m_events;
+}
@@ -0,0 +1,37 @@
+#pragma once
+#ifndef __CONTACT_TRACKER__
+#define __CONTACT_TRACKER__
+
+#include <utility>
+#include <vector>
+#include "ContactEvent.h"
+
+/*
+ * Turns the overlapping pairs found by the physics step into begin / stay / end events.
+ * The events for a frame are queued so gameplay, audio and logging can consume them
+ * in one batch after the physics step.
+ */
+class ContactTracker
+{
+public:
+	typedef std::pair<DisplayObject*, DisplayObject*> Contact;
+
+	ContactTracker();
+	~ContactTracker();
+
+	// report a pair that overlaps this frame
+	void addContact(DisplayObject* first, DisplayObject* second);
+
+	// compares this frame's contacts with last frame's and fills the event queue
+	void update();
+	void clear();
+
+	const std::vector<ContactEvent>& getEvents() const;
+
+private:
+	std::vector<Contact> m_previousContacts; // sorted
+	std::vector<Contact> m_currentContacts;
+	std::vector<ContactEvent> m_events;
+};
+
+#endif /* defined (__CONTACT_TRACKER__) */
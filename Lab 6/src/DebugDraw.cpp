@@ -0,0 +1,319 @@
+#include "DebugDraw.h"
+
+#include <cmath>
+#include <utility>
+#include "Renderer.h"
+#include "SpriteBatch.h"
+
+DebugDraw::DebugDraw()
+#ifndef DEBUG_DRAW_DISABLED
+	: m_lastBatch(0), m_submissionCount(0)
+#endif
+{
+}
+
+DebugDraw::~DebugDraw()
+= default;
+
+#ifndef DEBUG_DRAW_DISABLED
+
+void DebugDraw::drawLine(const glm::vec2 start, const glm::vec2 end, const glm::vec4 colour)
+{
+	const auto screen_start = Renderer::Instance().worldToScreen(start);
+	const auto screen_end = Renderer::Instance().worldToScreen(end);
+	const SDL_Point start_point = { static_cast<int>(screen_start.x), static_cast<int>(screen_start.y) };
+	const SDL_Point end_point = { static_cast<int>(screen_end.x), static_cast<int>(screen_end.y) };
+
+	auto& batch = m_getBatch(colour);
+
+	// a line that starts where the last one ended carries on the same strip
+	if (!batch.linePoints.empty() && batch.linePoints.back().x == start_point.x && batch.linePoints.back().y == start_point.y)
+	{
+		batch.linePoints.push_back(end_point);
+		return;
+	}
+
+	batch.lineStrips.push_back(static_cast<int>(batch.linePoints.size()));
+	batch.linePoints.push_back(start_point);
+	batch.linePoints.push_back(end_point);
+}
+
+void DebugDraw::drawRect(const glm::vec2 position, const int width, const int height, const glm::vec4 colour)
+{
+	m_getBatch(colour).rects.push_back(m_toScreen(position, width, height));
+}
+
+void DebugDraw::drawFilledRect(const glm::vec2 position, const int width, const int height, const glm::vec4 colour)
+{
+	m_getBatch(colour).filledRects.push_back(m_toScreen(position, width, height));
+}
+
+void DebugDraw::drawPoint(const glm::vec2 point, const glm::vec4 colour)
+{
+	const auto screen_point = Renderer::Instance().worldToScreen(point);
+	m_getBatch(colour).points.push_back({ static_cast<int>(screen_point.x), static_cast<int>(screen_point.y) });
+}
+
+void DebugDraw::drawCircle(const glm::vec2 centre, const int radius, const glm::vec4 colour, const ShapeType type)
+{
+	const auto screen_centre = Renderer::Instance().worldToScreen(centre);
+	const int centre_x = screen_centre.x;
+	const int centre_y = screen_centre.y;
+	const int screen_radius = ceil(radius * Renderer::Instance().getZoom());
+	const int diameter = floor(screen_radius * 2.0f);
+
+	auto& points = m_getBatch(colour).points;
+
+	int x = (screen_radius - 1);
+	int y = 0;
+	int tx = 1;
+	int ty = 1;
+	int error = (tx - diameter);
+
+	while (x >= y)
+	{
+		switch (type)
+		{
+		case SEMI_CIRCLE_TOP:
+			//  Each of the following renders an octant of the circle
+			points.push_back({ centre_x + x, centre_y - y });
+			points.push_back({ centre_x - x, centre_y - y });
+			points.push_back({ centre_x + y, centre_y - x });
+			points.push_back({ centre_x - y, centre_y - x });
+			break;
+		case SEMI_CIRCLE_BOTTOM:
+			//  Each of the following renders an octant of the circle
+			points.push_back({ centre_x + x, centre_y + y }); // bottom right
+			points.push_back({ centre_x - x, centre_y + y }); // bottom left
+			points.push_back({ centre_x + y, centre_y + x }); // bottom right
+			points.push_back({ centre_x - y, centre_y + x }); // bottom left
+			break;
+		case SEMI_CIRCLE_LEFT:
+			//  Each of the following renders an octant of the circle
+			points.push_back({ centre_x - x, centre_y - y });
+			points.push_back({ centre_x - x, centre_y + y });
+			points.push_back({ centre_x - y, centre_y - x });
+			points.push_back({ centre_x - y, centre_y + x });
+			break;
+		case SEMI_CIRCLE_RIGHT:
+			//  Each of the following renders an octant of the circle
+			points.push_back({ centre_x + x, centre_y - y });
+			points.push_back({ centre_x + x, centre_y + y });
+			points.push_back({ centre_x + y, centre_y - x });
+			points.push_back({ centre_x + y, centre_y + x });
+			break;
+		case SYMMETRICAL:
+			//  Each of the following renders an octant of the circle
+			points.push_back({ centre_x + x, centre_y - y });
+			points.push_back({ centre_x + x, centre_y + y });
+			points.push_back({ centre_x - x, centre_y - y });
+			points.push_back({ centre_x - x, centre_y + y });
+			points.push_back({ centre_x + y, centre_y - x });
+			points.push_back({ centre_x + y, centre_y + x });
+			points.push_back({ centre_x - y, centre_y - x });
+			points.push_back({ centre_x - y, centre_y + x });
+			break;
+		}
+
+		if (error <= 0)
+		{
+			++y;
+			error += ty;
+			ty += 2;
+		}
+
+		if (error > 0)
+		{
+			--x;
+			tx += 2;
+			error += (tx - diameter);
+		}
+	}
+}
+
+void DebugDraw::flush()
+{
+	m_submissionCount = 0;
+
+	// colours that were not used since the last flush are dropped so one-off colours don't pile up
+	for (size_t i = 0; i < m_batches.size();)
+	{
+		if (m_batches[i].isEmpty())
+		{
+			if (i + 1 < m_batches.size())
+			{
+				m_batches[i] = std::move(m_batches.back());
+			}
+			m_batches.pop_back();
+		}
+		else
+		{
+			++i;
+		}
+	}
+	m_lastBatch = 0;
+	if (m_batches.empty()) return;
+
+	SpriteBatch::Instance().flush(); // keep the pending sprites underneath
+
+	const auto renderer = Renderer::Instance().getRenderer();
+	m_fillRects();
+
+	for (auto& batch : m_batches)
+	{
+		if (batch.rects.empty() && batch.linePoints.empty() && batch.points.empty()) continue;
+
+		SDL_SetRenderDrawColor(renderer, batch.colour.r, batch.colour.g, batch.colour.b, batch.colour.a);
+
+		if (!batch.rects.empty())
+		{
+			SDL_RenderDrawRects(renderer, batch.rects.data(), static_cast<int>(batch.rects.size()));
+			++m_submissionCount;
+		}
+
+		for (size_t strip = 0; strip < batch.lineStrips.size(); ++strip)
+		{
+			const auto first = batch.lineStrips[strip];
+			const auto end = (strip + 1 < batch.lineStrips.size()) ? batch.lineStrips[strip + 1] : static_cast<int>(batch.linePoints.size());
+			SDL_RenderDrawLines(renderer, &batch.linePoints[first], end - first);
+			++m_submissionCount;
+		}
+
+		if (!batch.points.empty())
+		{
+			SDL_RenderDrawPoints(renderer, batch.points.data(), static_cast<int>(batch.points.size()));
+			++m_submissionCount;
+		}
+	}
+
+	SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+
+	for (auto& batch : m_batches)
+	{
+		batch.clear();
+	}
+}
+
+int DebugDraw::getSubmissionCount() const
+{
+	return m_submissionCount;
+}
+
+bool DebugDraw::Batch::isEmpty() const
+{
+	return filledRects.empty() && rects.empty() && linePoints.empty() && points.empty();
+}
+
+void DebugDraw::Batch::clear()
+{
+	// cleared rather than freed, so a steady frame doesn't allocate
+	filledRects.clear();
+	rects.clear();
+	linePoints.clear();
+	lineStrips.clear();
+	points.clear();
+}
+
+DebugDraw::Batch& DebugDraw::m_getBatch(const glm::vec4 colour)
+{
+	const SDL_Colour key = {
+		static_cast<Uint8>(floor(colour.r * 255.0f)), static_cast<Uint8>(floor(colour.g * 255.0f)),
+		static_cast<Uint8>(floor(colour.b * 255.0f)), static_cast<Uint8>(floor(colour.a * 255.0f)) };
+
+	const auto matches = [&key](const Batch& batch)
+	{
+		return batch.colour.r == key.r && batch.colour.g == key.g && batch.colour.b == key.b && batch.colour.a == key.a;
+	};
+
+	if (m_lastBatch < m_batches.size() && matches(m_batches[m_lastBatch]))
+	{
+		return m_batches[m_lastBatch];
+	}
+
+	for (size_t i = 0; i < m_batches.size(); ++i)
+	{
+		if (matches(m_batches[i]))
+		{
+			m_lastBatch = i;
+			return m_batches[i];
+		}
+	}
+
+	m_batches.emplace_back();
+	m_batches.back().colour = key;
+	m_lastBatch = m_batches.size() - 1;
+	return m_batches.back();
+}
+
+SDL_Rect DebugDraw::m_toScreen(const glm::vec2 position, const int width, const int height)
+{
+	const auto screen_position = Renderer::Instance().worldToScreen(position);
+	const auto zoom = Renderer::Instance().getZoom();
+	return { static_cast<int>(screen_position.x), static_cast<int>(screen_position.y),
+		static_cast<int>(ceil(width * zoom)), static_cast<int>(ceil(height * zoom)) };
+}
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+void DebugDraw::m_fillRects()
+{
+	// vertex colours let every colour share one call
+	static std::vector<SDL_Vertex> vertices;
+	static std::vector<int> indices;
+	vertices.clear();
+	indices.clear();
+
+	for (const auto& batch : m_batches)
+	{
+		for (const auto& rect : batch.filledRects)
+		{
+			const auto first_vertex = static_cast<int>(vertices.size());
+			const float corners[4][2] = {
+				{ static_cast<float>(rect.x), static_cast<float>(rect.y) },
+				{ static_cast<float>(rect.x + rect.w), static_cast<float>(rect.y) },
+				{ static_cast<float>(rect.x + rect.w), static_cast<float>(rect.y + rect.h) },
+				{ static_cast<float>(rect.x), static_cast<float>(rect.y + rect.h) }
+			};
+			for (const auto& corner : corners)
+			{
+				SDL_Vertex vertex;
+				vertex.position.x = corner[0];
+				vertex.position.y = corner[1];
+				vertex.color = batch.colour;
+				vertex.tex_coord.x = 0.0f;
+				vertex.tex_coord.y = 0.0f;
+				vertices.push_back(vertex);
+			}
+
+			for (const auto index : { 0, 1, 2, 0, 2, 3 })
+			{
+				indices.push_back(first_vertex + index);
+			}
+		}
+	}
+
+	if (vertices.empty()) return;
+
+	SDL_RenderGeometry(Renderer::Instance().getRenderer(), nullptr,
+		vertices.data(), static_cast<int>(vertices.size()), indices.data(), static_cast<int>(indices.size()));
+	++m_submissionCount;
+}
+
+#else
+
+void DebugDraw::m_fillRects()
+{
+	const auto renderer = Renderer::Instance().getRenderer();
+	for (const auto& batch : m_batches)
+	{
+		if (batch.filledRects.empty()) continue;
+
+		SDL_SetRenderDrawColor(renderer, batch.colour.r, batch.colour.g, batch.colour.b, batch.colour.a);
+		SDL_RenderFillRects(renderer, batch.filledRects.data(), static_cast<int>(batch.filledRects.size()));
+		++m_submissionCount;
+	}
+}
+
+#endif
+
+#endif /* !defined (DEBUG_DRAW_DISABLED) */
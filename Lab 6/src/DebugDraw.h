@@ -0,0 +1,81 @@
+#pragma once
+#ifndef __DEBUG_DRAW__
+#define __DEBUG_DRAW__
+
+#include <vector>
+#include <SDL.h>
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+#include "ShapeType.h"
+
+/* Singleton */
+/*
+ * Queues debug lines, rectangles, points and circles in screen space during a frame and draws them
+ * grouped by colour. Each colour sets the draw colour once and needs one SDL_RenderDrawRects,
+ * SDL_RenderDrawPoints and SDL_RenderFillRects call, plus one SDL_RenderDrawLines per connected run of lines.
+ * With SDL 2.0.18 or newer the filled rectangles of every colour go out in one SDL_RenderGeometry call.
+ * Filled rectangles are drawn before outlines, lines and points. Shapes of different colours are not
+ * kept in the order they were queued.
+ * Build with DEBUG_DRAW_DISABLED defined to compile every call down to nothing.
+ */
+class DebugDraw
+{
+public:
+	static DebugDraw& Instance()
+	{
+		static DebugDraw instance;
+		return instance;
+	}
+
+#ifndef DEBUG_DRAW_DISABLED
+	// positions and sizes are in world space and go through the active camera when queued
+	void drawLine(glm::vec2 start, glm::vec2 end, glm::vec4 colour);
+	void drawRect(glm::vec2 position, int width, int height, glm::vec4 colour);
+	void drawFilledRect(glm::vec2 position, int width, int height, glm::vec4 colour);
+	void drawPoint(glm::vec2 point, glm::vec4 colour);
+	void drawCircle(glm::vec2 centre, int radius, glm::vec4 colour, ShapeType type = SYMMETRICAL);
+
+	// draws everything queued so far - pending sprites are flushed first so they stay underneath
+	void flush();
+
+	// number of render calls the last flush made
+	int getSubmissionCount() const;
+#else
+	void drawLine(glm::vec2, glm::vec2, glm::vec4) {}
+	void drawRect(glm::vec2, int, int, glm::vec4) {}
+	void drawFilledRect(glm::vec2, int, int, glm::vec4) {}
+	void drawPoint(glm::vec2, glm::vec4) {}
+	void drawCircle(glm::vec2, int, glm::vec4, ShapeType = SYMMETRICAL) {}
+	void flush() {}
+	int getSubmissionCount() const { return 0; }
+#endif
+
+private:
+	DebugDraw();
+	~DebugDraw();
+
+#ifndef DEBUG_DRAW_DISABLED
+	// everything queued in one colour since the last flush
+	struct Batch
+	{
+		SDL_Colour colour;
+		std::vector<SDL_Rect> filledRects;
+		std::vector<SDL_Rect> rects;
+		std::vector<SDL_Point> linePoints; // line strips, one after the other
+		std::vector<int> lineStrips; // index of the first point of each strip in linePoints
+		std::vector<SDL_Point> points;
+		bool isEmpty() const;
+		void clear();
+	};
+
+	Batch& m_getBatch(glm::vec4 colour);
+	static SDL_Rect m_toScreen(glm::vec2 position, int width, int height);
+	void m_fillRects();
+
+	std::vector<Batch> m_batches;
+	size_t m_lastBatch; // colours tend to repeat, so the last batch is checked first
+	int m_submissionCount;
+#endif
+};
+
+#endif /* defined (__DEBUG_DRAW__) */
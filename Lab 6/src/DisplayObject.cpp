@@ -27,6 +27,53 @@ uint32_t DisplayObject::getLayerOrderIndex() const
 
 void DisplayObject::setLayerIndex(const uint32_t new_index, const uint32_t new_order)
 {
+	if (m_pParentScene != nullptr)
+	{
+		m_pParentScene->m_displayListDirty = true;
+		m_pParentScene->invalidateLayer(m_layerIndex);
+		m_pParentScene->invalidateLayer(new_index);
+	}
+
 	m_layerIndex = new_index;
 	m_layerOrderIndex = new_order;
 }
+
+void DisplayObject::setEnabled(const bool state)
+{
+	if (state != isEnabled() && m_pParentScene != nullptr)
+	{
+		m_pParentScene->m_displayListDirty = true;
+		m_pParentScene->invalidateLayer(m_layerIndex);
+	}
+
+	GameObject::setEnabled(state);
+}
+
+void DisplayObject::setVisible(const bool state)
+{
+	if (state != isVisible() && m_pParentScene != nullptr)
+	{
+		m_pParentScene->invalidateLayer(m_layerIndex);
+	}
+
+	GameObject::setVisible(state);
+}
+
+
+void DisplayObject::setType(const GameObjectType new_type)
+{
+	if (new_type == getType()) return;
+
+	const auto in_scene = m_pParentScene != nullptr && m_displayListIndex != -1;
+	if (in_scene)
+	{
+		m_pParentScene->m_removeFromBucket(this);
+	}
+
+	GameObject::setType(new_type);
+
+	if (in_scene)
+	{
+		m_pParentScene->m_addToBucket(this);
+	}
+}
\ No newline at end of file
@@ -34,13 +34,25 @@ public:
 	 * @param new_order The order within the layer, default is zero
 	 */
 	void setLayerIndex(uint32_t new_index, const uint32_t new_order = 0);
-	
+
+	// enabling or disabling moves the object between the parent scene's display list partitions
+	void setEnabled(bool state) override;
+	// showing or hiding redraws the object's layer if it is cached
+	void setVisible(bool state) override;
+
+	// changing the type moves the object to another of the parent scene's type buckets
+	void setType(GameObjectType new_type) override;
+
 
 private:
 	friend class Scene;
 	uint32_t m_layerIndex = 0;
 	uint32_t m_layerOrderIndex;
 	Scene* m_pParentScene{};
+
+	// slots in the parent scene's display list and type bucket, -1 when not in the scene
+	int m_displayListIndex = -1;
+	int m_typeBucketIndex = -1;
 };
 
 #endif /* defined (__DISPLAY_OBJECT__) */
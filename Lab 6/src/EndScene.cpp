@@ -48,13 +48,15 @@ void EndScene::handleEvents()
 
 void EndScene::start()
 {
+	TextureManager::Instance().beginAtlas("end_scene");
+
 	const SDL_Color blue = { 0, 0, 255, 255 };
-	m_label = new Label("END SCENE", "Dock51", 80, blue, glm::vec2(400.0f, 40.0f));
+	m_label = create<Label>("END SCENE", "Dock51", 80, blue, glm::vec2(400.0f, 40.0f));
 	m_label->setParent(this);
 	addChild(m_label);
 
 	// Restart Button
-	m_pRestartButton = new Button("../Assets/textures/restartButton.png", "restartButton", RESTART_BUTTON);
+	m_pRestartButton = create<Button>("../Assets/textures/restartButton.png", "restartButton", RESTART_BUTTON);
 	m_pRestartButton->getTransform()->position = glm::vec2(400.0f, 400.0f);
 	m_pRestartButton->addEventListener(CLICK, [&]()-> void
 	{
@@ -74,5 +76,7 @@ void EndScene::start()
 
 	addChild(m_pRestartButton);
 
+	TextureManager::Instance().endAtlas();
+
 	ImGuiWindowFrame::Instance().setDefaultGUIFunction();
 }
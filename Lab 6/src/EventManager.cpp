@@ -1,4 +1,5 @@
 #include "EventManager.h"
+#include <cstring>
 #include <iostream>
 #include "Game.h"
 
@@ -105,6 +106,12 @@ void EventManager::update()
                 }
                 break;
 
+            case SDL_RENDER_TARGETS_RESET:
+            case SDL_RENDER_DEVICE_RESET:
+                std::cout << "Render targets reset" << std::endl;
+                TheGame::Instance().onRenderTargetsReset();
+                break;
+
             case SDL_CONTROLLERDEVICEADDED:
                 std::cout << "Controller Added " << std::endl;
                 m_initializeControllers();
@@ -29,9 +29,15 @@ bool FontManager::load(const std::string& file_name, const std::string& id, cons
 
 bool FontManager::textToTexture(const std::string& text, const std::string& font_id, const std::string& texture_id, const SDL_Color colour)
 {
+	// already rendered and still cached - drawing it will mark it as recently used
+	if (TextureManager::Instance().getHandle(texture_id) != INVALID_TEXTURE_HANDLE)
+	{
+		return true;
+	}
+
 	//Render text surface
 
-	const auto textSurface(Config::make_resource(TTF_RenderText_Solid(m_fontMap[font_id].get(), text.c_str(), colour)));
+	const auto textSurface(Config::make_resource(TTF_RenderUTF8_Solid(m_fontMap[font_id].get(), text.c_str(), colour)));
 
 	if (textSurface == nullptr)
 	{
@@ -43,7 +49,7 @@ bool FontManager::textToTexture(const std::string& text, const std::string& font
 		const auto pTexture(Config::make_resource(SDL_CreateTextureFromSurface(/* TheGame::Instance()->getRenderer()*/ Renderer::Instance().getRenderer(), textSurface.get())));
 
 		//Create texture from surface pixels
-		TextureManager::Instance().addTexture(texture_id, pTexture);
+		TextureManager::Instance().addTextTexture(texture_id, pTexture);
 		if (TextureManager::Instance().getTexture(texture_id) == nullptr)
 		{
 			printf("Unable to create texture from rendered text! SDL Error: %s\n", SDL_GetError());
@@ -59,8 +65,27 @@ TTF_Font* FontManager::getFont(const std::string& id)
 	return m_fontMap[id].get();
 }
 
+GlyphAtlas* FontManager::getGlyphAtlas(const std::string& id)
+{
+	const auto atlas = m_glyphAtlasMap.find(id);
+	if (atlas != m_glyphAtlasMap.end())
+	{
+		return atlas->second.get();
+	}
+
+	const auto font = m_fontMap.find(id);
+	if (font == m_fontMap.end())
+	{
+		return nullptr;
+	}
+
+	return (m_glyphAtlasMap[id] = std::make_unique<GlyphAtlas>(font->second.get())).get();
+}
+
 void FontManager::clean()
 {
+	// the atlases refer to the fonts, so they go first
+	m_glyphAtlasMap.clear();
 	m_fontMap.clear();
 }
 
@@ -13,6 +13,7 @@
 #include <SDL_ttf.h>
 #include <string>
 #include "Config.h"
+#include "GlyphAtlas.h"
 
 class FontManager
 {
@@ -29,6 +30,8 @@ public:
 	bool load(const std::string& file_name, const std::string& id, int size, int style = TTF_STYLE_NORMAL);
 	bool textToTexture(const std::string& text, const std::string& font_id, const std::string& texture_id, SDL_Color colour = { 0, 0, 0, 255 });
 	TTF_Font* getFont(const std::string& id);
+	// glyph cache for a loaded font, created the first time it is asked for
+	GlyphAtlas* getGlyphAtlas(const std::string& id);
 	void clean();
 
 	void displayFontMap();
@@ -40,6 +43,7 @@ private:
 	bool m_exists(const std::string& id);
 
 	std::unordered_map<std::string, std::shared_ptr<TTF_Font>> m_fontMap;
+	std::unordered_map<std::string, std::unique_ptr<GlyphAtlas>> m_glyphAtlasMap;
 
 	static FontManager* s_pInstance;
 };
@@ -3,6 +3,7 @@
 #include <ctime>
 #include <iomanip>
 #include "glm/gtx/string_cast.hpp"
+#include "DebugDraw.h"
 #include "Renderer.h"
 #include "EventManager.h"
 
@@ -12,7 +13,7 @@
 // Game functions - DO NOT REMOVE ***********************************************
 
 Game::Game() :
-	m_pWindow(nullptr), m_bRunning(true), m_frames(0), m_currentScene(nullptr), m_currentSceneState(NO_SCENE)
+	m_pWindow(nullptr), m_bRunning(true), m_isHeadless(false), m_frames(0), m_currentScene(nullptr), m_currentSceneState(NO_SCENE)
 {
 	srand(unsigned(time(nullptr)));  // random seed
 }
@@ -94,6 +95,57 @@ bool Game::init(const char* title, const int x, const int y, const int width, co
 	return true;
 }
 
+bool Game::initHeadless(const int width, const int height)
+{
+	m_isHeadless = true;
+
+	// SoundManager opens the mixer on first use, which then gets a device that discards everything
+	SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+
+	// no video subsystem - nothing here needs a display
+	if (SDL_Init(SDL_INIT_TIMER | SDL_INIT_EVENTS) < 0)
+	{
+		std::cout << "SDL init failure" << std::endl;
+		return false;
+	}
+	std::cout << "SDL Init success (headless)" << std::endl;
+
+	m_pHeadlessSurface = Config::make_resource(SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA8888));
+	if (m_pHeadlessSurface == nullptr)
+	{
+		std::cout << "headless surface init failure" << std::endl;
+		return false;
+	}
+
+	Renderer::Instance().setRenderer(Config::make_resource(SDL_CreateSoftwareRenderer(m_pHeadlessSurface.get())));
+	if (Renderer::Instance().getRenderer() == nullptr)
+	{
+		std::cout << "renderer init failure" << std::endl;
+		return false;
+	}
+
+	// the event manager reads ImGui's input state, so the context is still needed
+	ImGuiWindowFrame::Instance().InitHeadless();
+
+	if (TTF_Init() == -1)
+	{
+		printf("SDL_ttf could not initialize! SDL_ttf Error: %s\n", TTF_GetError());
+		return false;
+	}
+
+	start();
+
+	std::cout << "init success" << std::endl;
+	m_bRunning = true;
+
+	return true;
+}
+
+bool Game::isHeadless() const
+{
+	return m_isHeadless;
+}
+
 void Game::start()
 {
 	m_currentSceneState = NO_SCENE;
@@ -187,11 +239,23 @@ void Game::quit()
 	m_bRunning = false;
 }
 
+void Game::onRenderTargetsReset() const
+{
+	if (m_currentScene != nullptr)
+	{
+		m_currentScene->onRenderTargetsReset();
+	}
+}
+
 void Game::render() const
 {
+	// nobody would see the frame
+	if (m_isHeadless) return;
+
 	SDL_RenderClear(Renderer::Instance().getRenderer()); // clear the renderer to the draw colour
 
 	m_currentScene->draw();
+	DebugDraw::Instance().flush(); // shapes a scene drew after its display list
 
 	SDL_RenderPresent(Renderer::Instance().getRenderer()); // draw to the screen
 
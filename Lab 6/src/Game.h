@@ -34,6 +34,13 @@ public:
 	// simply set the isRunning variable to true
 	void init();
 	bool init(const char* title, int x, int y, int width, int height, bool fullscreen);
+	/*
+	 * Starts the game with no window and no audio device. Textures are created by a software renderer
+	 * that draws into an off-screen surface so sizes and atlases still work, audio goes to SDL's dummy
+	 * driver and render() does nothing. Meant for running scene updates in batch jobs and benchmarks.
+	 */
+	bool initHeadless(int width, int height);
+	bool isHeadless() const;
 
 	// public life cycle functions
 	void render() const;
@@ -43,6 +50,9 @@ public:
 	void start();
 	void quit();
 
+	// passes SDL_RENDER_TARGETS_RESET / SDL_RENDER_DEVICE_RESET on to the current scene
+	void onRenderTargetsReset() const;
+
 	// getter and setter functions
 	glm::vec2 getMousePosition() const;
 
@@ -63,6 +73,7 @@ private:
 
 	// game properties
 	bool m_bRunning;
+	bool m_isHeadless;
 	Uint32 m_frames;
 	float m_deltaTime;
 	glm::vec2 m_mousePosition;
@@ -73,6 +84,7 @@ private:
 
 	// storage structures
 	std::shared_ptr<SDL_Window> m_pWindow;
+	std::shared_ptr<SDL_Surface> m_pHeadlessSurface; // target of the software renderer when headless
 };
 
 typedef Game TheGame;
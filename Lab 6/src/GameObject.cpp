@@ -1,21 +1,52 @@
 #include "GameObject.h"
 
+#include "ComponentManager.h"
+
 GameObject::GameObject() :
-	m_width(0), m_height(0), m_type(NONE), m_enabled(true), m_visible(true), m_isCentered(true)
+	m_entityId(-1), m_width(0), m_height(0), m_type(NONE), m_enabled(true), m_visible(true), m_isCentered(true),
+	m_collisionShape(RECTANGLE), m_orientation(0.0f)
 {
 }
 
 GameObject::~GameObject()
-= default;
+{
+	if (m_entityId != -1)
+	{
+		ComponentManager::Instance().destroyEntity(m_entityId);
+	}
+}
 
 Transform* GameObject::getTransform()
 {
-	return &m_transform;
+	return (m_entityId == -1) ? &m_transform : &ComponentManager::Instance().getTransform(m_entityId);
+}
+
+const Transform* GameObject::getTransform() const
+{
+	return (m_entityId == -1) ? &m_transform : &ComponentManager::Instance().getTransform(m_entityId);
 }
 
 RigidBody* GameObject::getRigidBody()
 {
-	return &m_rigidBody;
+	return (m_entityId == -1) ? &m_rigidBody : &ComponentManager::Instance().getRigidBody(m_entityId);
+}
+
+const RigidBody* GameObject::getRigidBody() const
+{
+	return (m_entityId == -1) ? &m_rigidBody : &ComponentManager::Instance().getRigidBody(m_entityId);
+}
+
+void GameObject::useComponentManager()
+{
+	if (m_entityId != -1) return;
+
+	m_entityId = ComponentManager::Instance().createEntity(m_transform, m_rigidBody);
+	m_syncBoundsOffsets();
+}
+
+int GameObject::getEntityId() const
+{
+	return m_entityId;
 }
 
 int GameObject::getWidth() const
@@ -36,11 +67,13 @@ GameObjectType GameObject::getType() const
 void GameObject::setWidth(const int new_width)
 {
 	m_width = new_width;
+	m_syncBoundsOffsets();
 }
 
 void GameObject::setHeight(const int new_height)
 {
 	m_height = new_height;
+	m_syncBoundsOffsets();
 }
 
 void GameObject::setType(const GameObjectType new_type)
@@ -71,9 +104,69 @@ bool GameObject::isVisible() const
 void GameObject::setIsCentered(bool state)
 {
 	m_isCentered = state;
+	m_syncBoundsOffsets();
 }
 
 bool GameObject::isCentered() const
 {
 	return m_isCentered;
 }
+
+CollisionShape GameObject::getCollisionShape() const
+{
+	return m_collisionShape;
+}
+
+void GameObject::setCollisionShape(const CollisionShape shape)
+{
+	m_collisionShape = shape;
+	m_syncBoundsOffsets();
+}
+
+float GameObject::getOrientation() const
+{
+	return m_orientation;
+}
+
+void GameObject::setOrientation(const float degrees)
+{
+	m_orientation = degrees;
+	m_syncBoundsOffsets();
+}
+
+AABB GameObject::getBounds() const
+{
+	if (m_collisionShape == ORIENTED_RECTANGLE)
+	{
+		return getOBB().getAABB();
+	}
+
+	auto top_left = getTransform()->position;
+	const auto size = glm::vec2(m_width, m_height);
+
+	if (m_isCentered)
+	{
+		top_left -= size * 0.5f;
+	}
+
+	return { top_left, top_left + size };
+}
+
+const OBB& GameObject::getOBB() const
+{
+	const auto half_extents = glm::vec2(m_width, m_height) * 0.5f;
+	m_obb.halfExtents = half_extents;
+	m_obb.centre = (m_isCentered) ? getTransform()->position : getTransform()->position + half_extents;
+	m_obb.setAngle(m_orientation);
+	return m_obb;
+}
+
+void GameObject::m_syncBoundsOffsets()
+{
+	if (m_entityId == -1) return;
+
+	// the bounds only move with the position, so the offsets stay valid until the collider itself changes
+	const auto bounds = getBounds();
+	const auto position = getTransform()->position;
+	ComponentManager::Instance().setBoundsOffsets(m_entityId, { bounds.lowerBound - position, bounds.upperBound - position });
+}
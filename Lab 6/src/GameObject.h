@@ -4,10 +4,13 @@
 
 #include "Transform.h"
 #include "RigidBody.h"
+#include "AABB.h"
+#include "OBB.h"
 #include <string>
 
 // enums
 #include "GameObjectType.h"
+#include "CollisionShape.h"
 
 
 class GameObject {
@@ -24,11 +27,17 @@ public:
 	// remove anything that needs to be deleted
 	virtual void clean() = 0;
 
-	// getters for common variables
+	// getters for common variables - the pointers are only valid until another object joins or leaves the ComponentManager
 	Transform* getTransform();
+	const Transform* getTransform() const;
 
 	// getters and setters for physics properties
 	RigidBody* getRigidBody();
+	const RigidBody* getRigidBody() const;
+
+	// opt in to dense component storage - moves the transform and rigid body into the ComponentManager
+	void useComponentManager();
+	int getEntityId() const;
 
 	// getters and setters for game object properties
 	int getWidth() const;
@@ -36,17 +45,28 @@ public:
 	void setWidth(int new_width);
 	void setHeight(int new_height);
 	GameObjectType getType() const;
-	void setType(GameObjectType new_type);
+	virtual void setType(GameObjectType new_type);
 
-	void setEnabled(bool state);
+	virtual void setEnabled(bool state);
 	bool isEnabled() const;
 
-	void setVisible(bool state);
+	virtual void setVisible(bool state);
 	bool isVisible() const;
 
 	void setIsCentered(bool state);
 	bool isCentered() const;
 
+	// getters and setters for collision properties
+	CollisionShape getCollisionShape() const;
+	void setCollisionShape(CollisionShape shape);
+	float getOrientation() const;
+	void setOrientation(float degrees);
+
+	// world bounds - tight around the OBB for ORIENTED_RECTANGLE colliders
+	AABB getBounds() const;
+	// oriented bounds - the axes are cached and only rebuilt when the orientation changes
+	const OBB& getOBB() const;
+
 private:
 	// transform component
 	Transform m_transform;
@@ -54,6 +74,9 @@ private:
 	// rigid body component
 	RigidBody m_rigidBody;
 
+	// ComponentManager entity, -1 while the components above are used
+	int m_entityId;
+
 	// size variables
 	int m_width;
 	int m_height;
@@ -62,6 +85,14 @@ private:
 	bool m_enabled;
 	bool m_visible;
 	bool m_isCentered;
+
+	// collision
+	CollisionShape m_collisionShape;
+	float m_orientation;
+	mutable OBB m_obb;
+
+	// passes the collider's extent around the position to the ComponentManager, which builds the world bounds from it
+	void m_syncBoundsOffsets();
 };
 
 #endif /* defined (__GAME_OBJECT__) */
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include "GlyphAtlas.h"
+
+#include <algorithm>
+#include "Config.h"
+#include "Renderer.h"
+#include "SpriteBatch.h"
+
+namespace
+{
+	// next code point of a UTF-8 string - a byte that doesn't start a valid sequence is taken as Latin-1
+	Uint32 nextCodePoint(const std::string& text, size_t& index)
+	{
+		const auto lead = static_cast<unsigned char>(text[index]);
+		const auto length = (lead < 0x80) ? 1 : ((lead >> 5) == 0x6) ? 2 : ((lead >> 4) == 0xE) ? 3 : ((lead >> 3) == 0x1E) ? 4 : 0;
+		if (length <= 1 || index + length > text.size())
+		{
+			++index;
+			return lead;
+		}
+
+		Uint32 code_point = lead & (0xFF >> (length + 1));
+		for (auto i = 1; i < length; ++i)
+		{
+			const auto continuation = static_cast<unsigned char>(text[index + i]);
+			if ((continuation >> 6) != 0x2)
+			{
+				++index;
+				return lead;
+			}
+			code_point = (code_point << 6) | (continuation & 0x3F);
+		}
+
+		index += length;
+		return code_point;
+	}
+}
+
+GlyphAtlas::GlyphAtlas(TTF_Font* font)
+	: m_pFont(font), m_lineHeight(TTF_FontHeight(font)), m_packer(PAGE_SIZE, PAGE_SIZE)
+{
+}
+
+GlyphAtlas::~GlyphAtlas()
+= default;
+
+bool GlyphAtlas::canDraw(const std::string& text)
+{
+	size_t index = 0;
+	while (index < text.size())
+	{
+		if (nextCodePoint(text, index) > 0xFFFF)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+glm::vec2 GlyphAtlas::measure(const std::string& text)
+{
+	auto right = 0;
+	m_layout(text, [&](const Glyph& glyph, const int pen_x)
+	{
+		right = std::max(right, std::max(pen_x + glyph.offsetX + glyph.rect.w, pen_x + glyph.advance));
+	});
+	return glm::vec2(right, m_lineHeight);
+}
+
+void GlyphAtlas::draw(const std::string& text, const glm::vec2 position, const SDL_Colour colour)
+{
+	const auto top_left = Renderer::Instance().worldToScreen(position);
+	const auto zoom = Renderer::Instance().getZoom();
+
+	m_layout(text, [&](const Glyph& glyph, const int pen_x)
+	{
+		if (glyph.page < 0) return;
+
+		const SDL_FRect dest = { top_left.x + (pen_x + glyph.offsetX) * zoom, top_left.y, glyph.rect.w * zoom, glyph.rect.h * zoom };
+		SpriteBatch::Instance().add(m_pages[glyph.page].get(), glyph.rect, dest, 0.0, colour);
+	});
+}
+
+template <typename Visitor>
+void GlyphAtlas::m_layout(const std::string& text, Visitor visit)
+{
+	auto pen_x = 0;
+	Uint16 previous = 0;
+
+	size_t index = 0;
+	while (index < text.size())
+	{
+		const auto code_point = nextCodePoint(text, index);
+		if (code_point > 0xFFFF) continue;
+
+		const auto current = static_cast<Uint16>(code_point);
+		if (previous != 0)
+		{
+			pen_x += TTF_GetFontKerningSizeGlyphs(m_pFont, previous, current);
+		}
+
+		const auto& glyph = m_getGlyph(current);
+		visit(glyph, pen_x);
+
+		pen_x += glyph.advance;
+		previous = current;
+	}
+}
+
+const GlyphAtlas::Glyph& GlyphAtlas::m_getGlyph(const Uint16 code_point)
+{
+	const auto cached = m_glyphs.find(code_point);
+	if (cached != m_glyphs.end())
+	{
+		return cached->second;
+	}
+
+	Glyph glyph{ -1, { 0, 0, 0, 0 }, 0, 0 };
+
+	int min_x, max_x, min_y, max_y;
+	// glyphs with no ink (spaces) only advance the pen
+	if (TTF_GlyphMetrics(m_pFont, code_point, &min_x, &max_x, &min_y, &max_y, &glyph.advance) == 0 && max_x > min_x)
+	{
+		// the rendered surface starts at the glyph's left edge when it reaches back past the pen
+		glyph.offsetX = std::min(min_x, 0);
+
+		// white, so the colour can be applied per quad
+		const auto pRendered(Config::make_resource(TTF_RenderGlyph_Blended(m_pFont, code_point, { 255, 255, 255, 255 })));
+		const auto pSurface = (pRendered != nullptr) ?
+			Config::make_resource(SDL_ConvertSurfaceFormat(pRendered.get(), SDL_PIXELFORMAT_RGBA32, 0)) : nullptr;
+
+		if (pSurface != nullptr && pSurface->w > 0 && pSurface->h > 0 &&
+			m_packer.pack(pSurface->w, pSurface->h, glyph.page, glyph.rect))
+		{
+			while (glyph.page >= static_cast<int>(m_pages.size()))
+			{
+				if (!m_addPage()) break;
+			}
+
+			if (glyph.page < static_cast<int>(m_pages.size()))
+			{
+				SDL_UpdateTexture(m_pages[glyph.page].get(), &glyph.rect, pSurface->pixels, pSurface->pitch);
+			}
+			else
+			{
+				glyph.page = -1;
+			}
+		}
+		else
+		{
+			glyph.page = -1;
+		}
+	}
+
+	return m_glyphs[code_point] = glyph;
+}
+
+bool GlyphAtlas::m_addPage()
+{
+	const auto renderer = Renderer::Instance().getRenderer();
+	const auto pTexture(Config::make_resource(SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, PAGE_SIZE, PAGE_SIZE)));
+	if (pTexture == nullptr)
+	{
+		return false;
+	}
+
+	// the padding between glyphs has to be transparent
+	const std::vector<Uint32> clear(PAGE_SIZE * PAGE_SIZE, 0);
+	SDL_UpdateTexture(pTexture.get(), nullptr, clear.data(), PAGE_SIZE * static_cast<int>(sizeof(Uint32)));
+	SDL_SetTextureBlendMode(pTexture.get(), SDL_BLENDMODE_BLEND);
+
+	m_pages.push_back(pTexture);
+	return true;
+}
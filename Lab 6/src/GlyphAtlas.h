@@ -0,0 +1,60 @@
+#pragma once
+#ifndef __GLYPH_ATLAS__
+#define __GLYPH_ATLAS__
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <glm/vec2.hpp>
+#include "RectanglePacker.h"
+
+/*
+ * Glyph cache for one font at one size. Each glyph is rasterised in white the first time it is
+ * used and copied into a shared page texture. A string is then drawn as one tinted quad per glyph
+ * through SpriteBatch, so changing text creates no textures.
+ * SDL_ttf 2.0.15 only renders single glyphs from the basic multilingual plane, so text with
+ * characters outside it can't be drawn here (see canDraw).
+ */
+class GlyphAtlas
+{
+public:
+	explicit GlyphAtlas(TTF_Font* font);
+	~GlyphAtlas();
+
+	// false if the (UTF-8) text has characters that have to be rendered as a whole string
+	static bool canDraw(const std::string& text);
+
+	// width and height of the text's single line in pixels
+	glm::vec2 measure(const std::string& text);
+	// position is the world space top left of the text
+	void draw(const std::string& text, glm::vec2 position, SDL_Colour colour);
+
+private:
+	struct Glyph
+	{
+		int page; // -1 if the glyph renders nothing (e.g. a space)
+		SDL_Rect rect;
+		int offsetX; // from the pen position to the left edge of the rendered glyph
+		int advance;
+	};
+
+	const Glyph& m_getGlyph(Uint16 code_point);
+	bool m_addPage();
+
+	// walks the text calling visit(glyph, pen_x) for every glyph, with kerning applied
+	template <typename Visitor>
+	void m_layout(const std::string& text, Visitor visit);
+
+	static const int PAGE_SIZE = 512;
+
+	TTF_Font* m_pFont;
+	int m_lineHeight;
+	std::unordered_map<Uint16, Glyph> m_glyphs;
+	std::vector<std::shared_ptr<SDL_Texture>> m_pages;
+	RectanglePacker m_packer;
+};
+
+#endif /* defined (__GLYPH_ATLAS__) */
@@ -50,6 +50,13 @@ void ImGuiWindowFrame::Init(const char* title, const int x, const int y, const i
 	}
 }
 
+void ImGuiWindowFrame::InitHeadless()
+{
+	m_windowID = 0;
+	ImGui::CreateContext();
+	setDefaultGUIFunction();
+}
+
 void ImGuiWindowFrame::Render()
 {
 	SDL_SetRenderDrawColor(getRenderer(), 255, 255, 255, 255);
@@ -107,7 +114,9 @@ void ImGuiWindowFrame::Start()
 	ImGui::StyleColorsDark();
 
 	// Hack to remove ghost window error - do not remove
-	Util::DrawRect(glm::vec2(0, 0), 1, 1, glm::vec4(1, 1, 1, 1), getRenderer());
+	// drawn straight to this window's renderer, debug shapes only go to the main one
+	const SDL_Rect pixel = { 0, 0, 1, 1 };
+	SDL_RenderDrawRect(getRenderer(), &pixel);
 }
 
 void ImGuiWindowFrame::Clean()
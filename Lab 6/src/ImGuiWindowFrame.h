@@ -16,6 +16,8 @@ public:
 	}
 
 	void Init(const char* title = "ImGui Window", int x = 900, int y = 100, int width = 512, int height = 512, int flags = SDL_WINDOW_RESIZABLE | SDL_WINDOW_HIDDEN | SDL_WINDOW_UTILITY);
+	// context only - no window or renderer, so Render must not be called
+	void InitHeadless();
 	void Render();
 	void Start();
 	void Clean();
@@ -3,22 +3,22 @@
 
 
 Label::Label(const std::string& text, const std::string& font_name, const int font_size, const SDL_Color colour, const glm::vec2 position, const int font_style, const bool is_centered):
-	m_fontColour(colour), m_fontName(font_name), m_text(text), m_isCentered(is_centered), m_fontSize(font_size), m_fontStyle(font_style)
+	m_pGlyphAtlas(nullptr), m_fontColour(colour), m_fontName(font_name), m_text(text), m_isCentered(is_centered), m_fontSize(font_size), m_fontStyle(font_style)
 {
 	m_fontPath = "../Assets/fonts/" + font_name + ".ttf";
 
-	m_buildFontID();
-
-	FontManager::Instance()->load(m_fontPath, m_fontID, font_size, font_style);
-	FontManager::Instance()->textToTexture(text, m_fontID, m_fontID, colour);
-	const auto size = TextureManager::Instance().getTextureSize(m_fontID);
-	setWidth(size.x);
-	setHeight(size.y);
+	m_loadFont();
+	m_refresh();
 	getTransform()->position = position;
 }
 
 Label::~Label()
-= default;
+{
+	if (!m_textureID.empty())
+	{
+		TextureManager::Instance().releaseTextTexture(m_textureID);
+	}
+}
 
 void Label::draw()
 {
@@ -27,7 +27,21 @@ void Label::draw()
 	const auto y = getTransform()->position.y;
 
 	// draw the label
-	TextureManager::Instance().drawText(m_fontID, x, y, 0, 255, m_isCentered);
+	if (m_textureID.empty())
+	{
+		if (m_pGlyphAtlas == nullptr) return;
+
+		auto top_left = glm::vec2(x, y);
+		if (m_isCentered)
+		{
+			top_left -= glm::vec2(static_cast<int>(getWidth() * 0.5), static_cast<int>(getHeight() * 0.5));
+		}
+		m_pGlyphAtlas->draw(m_text, top_left, m_fontColour);
+	}
+	else
+	{
+		TextureManager::Instance().drawText(m_textureID, x, y, 0, 255, m_isCentered);
+	}
 }
 
 void Label::update()
@@ -41,35 +55,26 @@ void Label::clean()
 
 void Label::setText(const std::string& new_text)
 {
-
 	m_text = new_text;
-
-	m_buildFontID();
-
-	FontManager::Instance()->load(m_fontPath, m_fontID, m_fontSize, m_fontStyle);
-	FontManager::Instance()->textToTexture(new_text, m_fontID, m_fontID, m_fontColour);
-	const auto size = TextureManager::Instance().getTextureSize(m_fontID);
-	setWidth(size.x);
-	setHeight(size.y);
+	m_refresh();
 }
 
-void Label::setColour(const SDL_Color new_colour) const
+void Label::setColour(const SDL_Color new_colour)
 {
-	FontManager::Instance()->load(m_fontPath, m_fontID, m_fontSize, m_fontStyle);
-	FontManager::Instance()->textToTexture(m_text, m_fontID, m_fontID, new_colour);
+	m_fontColour = new_colour;
+
+	// glyphs are tinted when drawn, only a whole-string texture has the colour baked in
+	if (!m_textureID.empty())
+	{
+		m_refresh();
+	}
 }
 
 void Label::setSize(const int new_size)
 {
 	m_fontSize = new_size;
-
-	m_buildFontID();
-	
-	FontManager::Instance()->load(m_fontPath, m_fontID, m_fontSize, TTF_STYLE_NORMAL);
-	FontManager::Instance()->textToTexture(m_text, m_fontID, m_fontID, m_fontColour);
-	const auto size = TextureManager::Instance().getTextureSize(m_fontID);
-	setWidth(size.x);
-	setHeight(size.y);
+	m_loadFont();
+	m_refresh();
 }
 
 void Label::m_buildFontID()
@@ -78,6 +83,48 @@ void Label::m_buildFontID()
 	m_fontID += "-";
 	m_fontID += std::to_string(m_fontSize);
 	m_fontID += "-";
-	m_fontID += m_text;
+	m_fontID += std::to_string(m_fontStyle);
+}
+
+void Label::m_loadFont()
+{
+	m_buildFontID();
+	FontManager::Instance()->load(m_fontPath, m_fontID, m_fontSize, m_fontStyle);
+	m_pGlyphAtlas = FontManager::Instance()->getGlyphAtlas(m_fontID);
 }
 
+void Label::m_refresh()
+{
+	std::string texture_id;
+	glm::vec2 size;
+	if (GlyphAtlas::canDraw(m_text))
+	{
+		// measuring also rasterises any glyph the cache hasn't seen yet
+		size = (m_pGlyphAtlas != nullptr) ? m_pGlyphAtlas->measure(m_text) : glm::vec2(0.0f, 0.0f);
+	}
+	else
+	{
+		// the colour is baked into the texture, so it is part of the id
+		texture_id = m_fontID + "-" + std::to_string(m_fontColour.r) + "." + std::to_string(m_fontColour.g) + "." +
+			std::to_string(m_fontColour.b) + "." + std::to_string(m_fontColour.a) + "-" + m_text;
+		FontManager::Instance()->textToTexture(m_text, m_fontID, texture_id, m_fontColour);
+		size = TextureManager::Instance().getTextureSize(texture_id);
+	}
+
+	// hold the new text texture before letting go of the old one, so a shared texture is never dropped in between
+	if (texture_id != m_textureID)
+	{
+		if (!texture_id.empty())
+		{
+			TextureManager::Instance().acquireTextTexture(texture_id);
+		}
+		if (!m_textureID.empty())
+		{
+			TextureManager::Instance().releaseTextTexture(m_textureID);
+		}
+		m_textureID = texture_id;
+	}
+
+	setWidth(size.x);
+	setHeight(size.y);
+}
@@ -19,12 +19,14 @@ public:
 	virtual void clean() override;
 
 	void setText(const std::string& new_text);
-	void setColour(SDL_Color new_colour) const;
+	void setColour(SDL_Color new_colour);
 	void setSize(int new_size);
 
 private:
 	std::string m_fontPath;
-	std::string m_fontID;
+	std::string m_fontID; // font name, size and style - one font and glyph cache per id
+	std::string m_textureID; // only used for text the glyph cache can't draw
+	GlyphAtlas* m_pGlyphAtlas;
 	SDL_Color m_fontColour;
 	std::string m_fontName;
 	std::string m_text;
@@ -33,6 +35,8 @@ private:
 	int m_fontStyle;
 
 	void m_buildFontID();
+	void m_loadFont();
+	void m_refresh();
 };
 
 #endif /* defined (__LABEL__) */
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "LayerCache.h"
+
+#include "Camera.h"
+#include "Config.h"
+#include "DebugDraw.h"
+#include "Renderer.h"
+#include "SpriteBatch.h"
+
+LayerCache::LayerCache()
+	: m_width(0), m_height(0), m_pPreviousTarget(nullptr), m_valid(false), m_cameraPosition(0.0f, 0.0f), m_cameraZoom(1.0f)
+{
+}
+
+LayerCache::~LayerCache()
+= default;
+
+bool LayerCache::isValid(const Camera& camera) const
+{
+	if (!m_valid || m_pTexture == nullptr ||
+		camera.getPosition() != m_cameraPosition || camera.getZoom() != m_cameraZoom)
+	{
+		return false;
+	}
+
+	// a capture from before a resize would be stretched over the new output
+	int width, height;
+	SDL_GetRendererOutputSize(Renderer::Instance().getRenderer(), &width, &height);
+	return width == m_width && height == m_height;
+}
+
+void LayerCache::invalidate()
+{
+	m_valid = false;
+}
+
+void LayerCache::release()
+{
+	m_pTexture = nullptr;
+	m_width = 0;
+	m_height = 0;
+	m_valid = false;
+}
+
+bool LayerCache::beginCapture()
+{
+	const auto renderer = Renderer::Instance().getRenderer();
+	if (SDL_RenderTargetSupported(renderer) == SDL_FALSE)
+	{
+		return false;
+	}
+
+	// (re)create the target when the output size changes
+	int width, height;
+	SDL_GetRendererOutputSize(renderer, &width, &height);
+	if (m_pTexture == nullptr || width != m_width || height != m_height)
+	{
+		const auto texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
+		if (texture == nullptr)
+		{
+			return false;
+		}
+		SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+		m_pTexture = Config::make_resource(texture);
+		m_width = width;
+		m_height = height;
+	}
+
+	// sprites and debug shapes queued so far belong to the previous target
+	SpriteBatch::Instance().flush();
+	DebugDraw::Instance().flush();
+	m_pPreviousTarget = SDL_GetRenderTarget(renderer);
+	SDL_SetRenderTarget(renderer, m_pTexture.get());
+
+	// start from fully transparent so the layers underneath show through
+	SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+	SDL_RenderClear(renderer);
+	SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+	return true;
+}
+
+void LayerCache::endCapture(const Camera& camera)
+{
+	SpriteBatch::Instance().flush();
+	DebugDraw::Instance().flush();
+	SDL_SetRenderTarget(Renderer::Instance().getRenderer(), m_pPreviousTarget);
+	m_pPreviousTarget = nullptr;
+
+	m_cameraPosition = camera.getPosition();
+	m_cameraZoom = camera.getZoom();
+	m_valid = true;
+}
+
+void LayerCache::draw() const
+{
+	if (m_pTexture == nullptr) return;
+
+	SpriteBatch::Instance().flush();
+	DebugDraw::Instance().flush();
+
+	SDL_RenderCopy(Renderer::Instance().getRenderer(), m_pTexture.get(), nullptr, nullptr);
+}
@@ -0,0 +1,46 @@
+#pragma once
+#ifndef __LAYER_CACHE__
+#define __LAYER_CACHE__
+
+#include <memory>
+#include <SDL.h>
+#include <glm/vec2.hpp>
+
+class Camera;
+
+/*
+ * Render-target texture holding one fully drawn display list layer.
+ * While the cache is valid the whole layer is drawn with a single copy. It becomes invalid
+ * when the scene (or the caller through Scene::invalidateLayer) says the layer's content
+ * changed, when the camera has moved or zoomed since the layer was captured, or when the
+ * renderer's output size no longer matches the texture.
+ */
+class LayerCache
+{
+public:
+	LayerCache();
+	~LayerCache();
+
+	bool isValid(const Camera& camera) const;
+	void invalidate();
+	// drops the texture as well - for when the renderer has lost the contents of its targets
+	void release();
+
+	// redirects rendering into the cache texture - returns false if no target texture could be made
+	bool beginCapture();
+	void endCapture(const Camera& camera);
+
+	void draw() const;
+
+private:
+	std::shared_ptr<SDL_Texture> m_pTexture;
+	int m_width;
+	int m_height;
+	SDL_Texture* m_pPreviousTarget;
+
+	bool m_valid;
+	glm::vec2 m_cameraPosition;
+	float m_cameraZoom;
+};
+
+#endif /* defined (__LAYER_CACHE__) */
@@ -0,0 +1,281 @@
+#include "NarrowPhaseBatch.h"
+
+#include <algorithm>
+#include <cmath>
+
+// the AVX2 kernels are compiled for x86 only and picked at runtime, so the build needs no /arch flag
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define NARROW_PHASE_AVX2
+#define NARROW_PHASE_AVX2_TARGET
+#include <intrin.h>
+#include <immintrin.h>
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define NARROW_PHASE_AVX2
+#define NARROW_PHASE_AVX2_TARGET __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif
+
+NarrowPhaseBatch::NarrowPhaseBatch()
+= default;
+
+NarrowPhaseBatch::~NarrowPhaseBatch()
+= default;
+
+int NarrowPhaseBatch::addCircleCirclePair(const glm::vec2 centre1, const float radius1, const glm::vec2 centre2, const float radius2)
+{
+	auto& pairs = m_circleCirclePairs;
+	pairs.x1.push_back(centre1.x);
+	pairs.y1.push_back(centre1.y);
+	pairs.radius1.push_back(radius1);
+	pairs.x2.push_back(centre2.x);
+	pairs.y2.push_back(centre2.y);
+	pairs.radius2.push_back(radius2);
+
+	return static_cast<int>(pairs.x1.size()) - 1;
+}
+
+int NarrowPhaseBatch::addCircleAABBPair(const glm::vec2 circle_centre, const float circle_radius, const AABB& box)
+{
+	auto& pairs = m_circleAABBPairs;
+	pairs.circleX.push_back(circle_centre.x);
+	pairs.circleY.push_back(circle_centre.y);
+	pairs.radius.push_back(circle_radius);
+	pairs.boxX.push_back((box.lowerBound.x + box.upperBound.x) * 0.5f);
+	pairs.boxY.push_back((box.lowerBound.y + box.upperBound.y) * 0.5f);
+	pairs.halfWidth.push_back((box.upperBound.x - box.lowerBound.x) * 0.5f);
+	pairs.halfHeight.push_back((box.upperBound.y - box.lowerBound.y) * 0.5f);
+
+	return static_cast<int>(pairs.circleX.size()) - 1;
+}
+
+int NarrowPhaseBatch::addAABBPair(const AABB& box1, const AABB& box2)
+{
+	auto& pairs = m_AABBPairs;
+	pairs.x1.push_back((box1.lowerBound.x + box1.upperBound.x) * 0.5f);
+	pairs.y1.push_back((box1.lowerBound.y + box1.upperBound.y) * 0.5f);
+	pairs.halfWidth1.push_back((box1.upperBound.x - box1.lowerBound.x) * 0.5f);
+	pairs.halfHeight1.push_back((box1.upperBound.y - box1.lowerBound.y) * 0.5f);
+	pairs.x2.push_back((box2.lowerBound.x + box2.upperBound.x) * 0.5f);
+	pairs.y2.push_back((box2.lowerBound.y + box2.upperBound.y) * 0.5f);
+	pairs.halfWidth2.push_back((box2.upperBound.x - box2.lowerBound.x) * 0.5f);
+	pairs.halfHeight2.push_back((box2.upperBound.y - box2.lowerBound.y) * 0.5f);
+
+	return static_cast<int>(pairs.x1.size()) - 1;
+}
+
+void NarrowPhaseBatch::clear()
+{
+	// clear() keeps the capacity, so a scene that refills the batch every frame stops allocating
+	for (auto* list : { &m_circleCirclePairs.x1, &m_circleCirclePairs.y1, &m_circleCirclePairs.radius1,
+		&m_circleCirclePairs.x2, &m_circleCirclePairs.y2, &m_circleCirclePairs.radius2,
+		&m_circleAABBPairs.circleX, &m_circleAABBPairs.circleY, &m_circleAABBPairs.radius,
+		&m_circleAABBPairs.boxX, &m_circleAABBPairs.boxY, &m_circleAABBPairs.halfWidth, &m_circleAABBPairs.halfHeight,
+		&m_AABBPairs.x1, &m_AABBPairs.y1, &m_AABBPairs.halfWidth1, &m_AABBPairs.halfHeight1,
+		&m_AABBPairs.x2, &m_AABBPairs.y2, &m_AABBPairs.halfWidth2, &m_AABBPairs.halfHeight2 })
+	{
+		list->clear();
+	}
+
+	m_circleCircleHits.clear();
+	m_circleAABBHits.clear();
+	m_AABBHits.clear();
+}
+
+void NarrowPhaseBatch::update()
+{
+	m_circleCircleHits.clear();
+	m_circleAABBHits.clear();
+	m_AABBHits.clear();
+
+	static const auto use_avx2 = hasAVX2();
+
+	auto first = use_avx2 ? m_circleCircleAVX2(m_circleCirclePairs, m_circleCircleHits) : 0;
+	m_circleCircleScalar(m_circleCirclePairs, first, static_cast<int>(m_circleCirclePairs.x1.size()), m_circleCircleHits);
+
+	first = use_avx2 ? m_circleAABBAVX2(m_circleAABBPairs, m_circleAABBHits) : 0;
+	m_circleAABBScalar(m_circleAABBPairs, first, static_cast<int>(m_circleAABBPairs.circleX.size()), m_circleAABBHits);
+
+	first = use_avx2 ? m_AABBAVX2(m_AABBPairs, m_AABBHits) : 0;
+	m_AABBScalar(m_AABBPairs, first, static_cast<int>(m_AABBPairs.x1.size()), m_AABBHits);
+}
+
+const std::vector<int>& NarrowPhaseBatch::getCircleCircleHits() const
+{
+	return m_circleCircleHits;
+}
+
+const std::vector<int>& NarrowPhaseBatch::getCircleAABBHits() const
+{
+	return m_circleAABBHits;
+}
+
+const std::vector<int>& NarrowPhaseBatch::getAABBHits() const
+{
+	return m_AABBHits;
+}
+
+bool NarrowPhaseBatch::hasAVX2()
+{
+#if defined(NARROW_PHASE_AVX2) && defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7) return false;
+
+	// the CPU has to support AVX and the OS has to save the ymm registers
+	__cpuid(info, 1);
+	const auto os_saves_ymm = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+	if (!os_saves_ymm) return false;
+
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#elif defined(NARROW_PHASE_AVX2)
+	return __builtin_cpu_supports("avx2");
+#else
+	return false;
+#endif
+}
+
+/* ------------------------------------------------------------------------------------------------ */
+/* scalar kernels                                                                                   */
+/* ------------------------------------------------------------------------------------------------ */
+
+void NarrowPhaseBatch::m_circleCircleScalar(const CircleCirclePairs& pairs, const int first, const int last, std::vector<int>& hits)
+{
+	for (auto i = first; i < last; ++i)
+	{
+		const auto dx = pairs.x2[i] - pairs.x1[i];
+		const auto dy = pairs.y2[i] - pairs.y1[i];
+		const auto radii = pairs.radius1[i] + pairs.radius2[i];
+		if (dx * dx + dy * dy < radii * radii)
+		{
+			hits.push_back(i);
+		}
+	}
+}
+
+void NarrowPhaseBatch::m_circleAABBScalar(const CircleAABBPairs& pairs, const int first, const int last, std::vector<int>& hits)
+{
+	for (auto i = first; i < last; ++i)
+	{
+		// distance from the circle centre to the closest point of the box on each axis
+		const auto dx = std::max(std::abs(pairs.circleX[i] - pairs.boxX[i]) - pairs.halfWidth[i], 0.0f);
+		const auto dy = std::max(std::abs(pairs.circleY[i] - pairs.boxY[i]) - pairs.halfHeight[i], 0.0f);
+		if (dx * dx + dy * dy <= pairs.radius[i] * pairs.radius[i])
+		{
+			hits.push_back(i);
+		}
+	}
+}
+
+void NarrowPhaseBatch::m_AABBScalar(const AABBPairs& pairs, const int first, const int last, std::vector<int>& hits)
+{
+	for (auto i = first; i < last; ++i)
+	{
+		if (std::abs(pairs.x2[i] - pairs.x1[i]) < pairs.halfWidth1[i] + pairs.halfWidth2[i] &&
+			std::abs(pairs.y2[i] - pairs.y1[i]) < pairs.halfHeight1[i] + pairs.halfHeight2[i])
+		{
+			hits.push_back(i);
+		}
+	}
+}
+
+/* ------------------------------------------------------------------------------------------------ */
+/* AVX2 kernels                                                                                     */
+/* ------------------------------------------------------------------------------------------------ */
+
+#if defined(NARROW_PHASE_AVX2)
+
+namespace
+{
+	NARROW_PHASE_AVX2_TARGET inline __m256 abs8(const __m256 value)
+	{
+		return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), value);
+	}
+
+	// appends base + lane for every set lane of the comparison mask
+	inline void appendHits(const int mask, const int base, std::vector<int>& hits)
+	{
+		for (auto lane = 0; lane < 8; ++lane)
+		{
+			if (mask & (1 << lane))
+			{
+				hits.push_back(base + lane);
+			}
+		}
+	}
+}
+
+NARROW_PHASE_AVX2_TARGET int NarrowPhaseBatch::m_circleCircleAVX2(const CircleCirclePairs& pairs, std::vector<int>& hits)
+{
+	const auto count = static_cast<int>(pairs.x1.size());
+	auto i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		const auto dx = _mm256_sub_ps(_mm256_loadu_ps(&pairs.x2[i]), _mm256_loadu_ps(&pairs.x1[i]));
+		const auto dy = _mm256_sub_ps(_mm256_loadu_ps(&pairs.y2[i]), _mm256_loadu_ps(&pairs.y1[i]));
+		const auto radii = _mm256_add_ps(_mm256_loadu_ps(&pairs.radius1[i]), _mm256_loadu_ps(&pairs.radius2[i]));
+
+		const auto squared_distance = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+		const auto overlap = _mm256_cmp_ps(squared_distance, _mm256_mul_ps(radii, radii), _CMP_LT_OQ);
+		appendHits(_mm256_movemask_ps(overlap), i, hits);
+	}
+	return i;
+}
+
+NARROW_PHASE_AVX2_TARGET int NarrowPhaseBatch::m_circleAABBAVX2(const CircleAABBPairs& pairs, std::vector<int>& hits)
+{
+	const auto zero = _mm256_setzero_ps();
+	const auto count = static_cast<int>(pairs.circleX.size());
+	auto i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		const auto offset_x = abs8(_mm256_sub_ps(_mm256_loadu_ps(&pairs.circleX[i]), _mm256_loadu_ps(&pairs.boxX[i])));
+		const auto offset_y = abs8(_mm256_sub_ps(_mm256_loadu_ps(&pairs.circleY[i]), _mm256_loadu_ps(&pairs.boxY[i])));
+		const auto dx = _mm256_max_ps(_mm256_sub_ps(offset_x, _mm256_loadu_ps(&pairs.halfWidth[i])), zero);
+		const auto dy = _mm256_max_ps(_mm256_sub_ps(offset_y, _mm256_loadu_ps(&pairs.halfHeight[i])), zero);
+		const auto radius = _mm256_loadu_ps(&pairs.radius[i]);
+
+		const auto squared_distance = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+		const auto overlap = _mm256_cmp_ps(squared_distance, _mm256_mul_ps(radius, radius), _CMP_LE_OQ);
+		appendHits(_mm256_movemask_ps(overlap), i, hits);
+	}
+	return i;
+}
+
+NARROW_PHASE_AVX2_TARGET int NarrowPhaseBatch::m_AABBAVX2(const AABBPairs& pairs, std::vector<int>& hits)
+{
+	const auto count = static_cast<int>(pairs.x1.size());
+	auto i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		const auto dx = abs8(_mm256_sub_ps(_mm256_loadu_ps(&pairs.x2[i]), _mm256_loadu_ps(&pairs.x1[i])));
+		const auto dy = abs8(_mm256_sub_ps(_mm256_loadu_ps(&pairs.y2[i]), _mm256_loadu_ps(&pairs.y1[i])));
+		const auto half_widths = _mm256_add_ps(_mm256_loadu_ps(&pairs.halfWidth1[i]), _mm256_loadu_ps(&pairs.halfWidth2[i]));
+		const auto half_heights = _mm256_add_ps(_mm256_loadu_ps(&pairs.halfHeight1[i]), _mm256_loadu_ps(&pairs.halfHeight2[i]));
+
+		const auto overlap = _mm256_and_ps(_mm256_cmp_ps(dx, half_widths, _CMP_LT_OQ), _mm256_cmp_ps(dy, half_heights, _CMP_LT_OQ));
+		appendHits(_mm256_movemask_ps(overlap), i, hits);
+	}
+	return i;
+}
+
+#else
+
+// no AVX2 on this target - update() never calls these, they only hand everything to the scalar kernels
+
+int NarrowPhaseBatch::m_circleCircleAVX2(const CircleCirclePairs&, std::vector<int>&)
+{
+	return 0;
+}
+
+int NarrowPhaseBatch::m_circleAABBAVX2(const CircleAABBPairs&, std::vector<int>&)
+{
+	return 0;
+}
+
+int NarrowPhaseBatch::m_AABBAVX2(const AABBPairs&, std::vector<int>&)
+{
+	return 0;
+}
+
+#endif
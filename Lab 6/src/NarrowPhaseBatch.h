@@ -0,0 +1,76 @@
+#pragma once
+#ifndef __NARROW_PHASE_BATCH__
+#define __NARROW_PHASE_BATCH__
+
+#include <vector>
+#include <glm/vec2.hpp>
+#include "AABB.h"
+
+/*
+ * Batched narrow phase for large numbers of candidate pairs.
+ * Pairs are queued into flat structure-of-arrays lists (centres, radii, half extents)
+ * so the kernels never touch a GameObject. update() tests 8 pairs at a time with AVX2
+ * when the CPU supports it and falls back to a scalar loop otherwise. The overlapping
+ * pairs are written to a compact hit list of pair indices.
+ */
+class NarrowPhaseBatch
+{
+public:
+	NarrowPhaseBatch();
+	~NarrowPhaseBatch();
+
+	// queue a candidate pair - returns its index in that pair list
+	int addCircleCirclePair(glm::vec2 centre1, float radius1, glm::vec2 centre2, float radius2);
+	int addCircleAABBPair(glm::vec2 circle_centre, float circle_radius, const AABB& box);
+	int addAABBPair(const AABB& box1, const AABB& box2);
+	void clear();
+
+	// runs every kernel and refills the hit lists (indices in ascending order)
+	void update();
+
+	const std::vector<int>& getCircleCircleHits() const;
+	const std::vector<int>& getCircleAABBHits() const;
+	const std::vector<int>& getAABBHits() const;
+
+	static bool hasAVX2();
+
+private:
+	struct CircleCirclePairs
+	{
+		std::vector<float> x1, y1, radius1;
+		std::vector<float> x2, y2, radius2;
+	};
+
+	// boxes are stored as centre and half extents
+	struct CircleAABBPairs
+	{
+		std::vector<float> circleX, circleY, radius;
+		std::vector<float> boxX, boxY, halfWidth, halfHeight;
+	};
+
+	struct AABBPairs
+	{
+		std::vector<float> x1, y1, halfWidth1, halfHeight1;
+		std::vector<float> x2, y2, halfWidth2, halfHeight2;
+	};
+
+	CircleCirclePairs m_circleCirclePairs;
+	CircleAABBPairs m_circleAABBPairs;
+	AABBPairs m_AABBPairs;
+
+	std::vector<int> m_circleCircleHits;
+	std::vector<int> m_circleAABBHits;
+	std::vector<int> m_AABBHits;
+
+	// scalar kernels - also used for the tail the vector kernels leave behind
+	static void m_circleCircleScalar(const CircleCirclePairs& pairs, int first, int last, std::vector<int>& hits);
+	static void m_circleAABBScalar(const CircleAABBPairs& pairs, int first, int last, std::vector<int>& hits);
+	static void m_AABBScalar(const AABBPairs& pairs, int first, int last, std::vector<int>& hits);
+
+	// AVX2 kernels - return the index of the first pair left for the scalar tail
+	static int m_circleCircleAVX2(const CircleCirclePairs& pairs, std::vector<int>& hits);
+	static int m_circleAABBAVX2(const CircleAABBPairs& pairs, std::vector<int>& hits);
+	static int m_AABBAVX2(const AABBPairs& pairs, std::vector<int>& hits);
+};
+
+#endif /* defined (__NARROW_PHASE_BATCH__) */
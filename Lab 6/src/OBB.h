@@ -0,0 +1,37 @@
+#pragma once
+#ifndef __OBB__
+#define __OBB__
+#include <cmath>
+#include <glm/vec2.hpp>
+#include "AABB.h"
+
+struct OBB
+{
+	glm::vec2 centre;
+	glm::vec2 halfExtents; // along the local axes
+	glm::vec2 axes[2] = { glm::vec2(1.0f, 0.0f), glm::vec2(0.0f, 1.0f) }; // unit local x and y
+	float angle = 0.0f; // degrees the axes were built for
+
+	// rebuilds the axes only when the orientation has changed
+	void setAngle(const float degrees)
+	{
+		if (degrees == angle) return;
+
+		angle = degrees;
+		const auto radians = degrees * 0.0174532925f;
+		const auto c = std::cos(radians);
+		const auto s = std::sin(radians);
+		axes[0] = glm::vec2(c, s);
+		axes[1] = glm::vec2(-s, c);
+	}
+
+	// tight world aligned bounds of the box
+	AABB getAABB() const
+	{
+		const auto extent_x = std::abs(axes[0].x) * halfExtents.x + std::abs(axes[1].x) * halfExtents.y;
+		const auto extent_y = std::abs(axes[0].y) * halfExtents.x + std::abs(axes[1].y) * halfExtents.y;
+		const auto extent = glm::vec2(extent_x, extent_y);
+		return { centre - extent, centre + extent };
+	}
+};
+#endif /* defined (__OBB__) */
@@ -6,9 +6,9 @@
 
 Obstacle::Obstacle()
 {
-	TextureManager::Instance().load("../Assets/textures/obstacle.png", "obstacle");
+	m_textureHandle = TextureManager::Instance().load("../Assets/textures/obstacle.png", "obstacle");
 
-	auto size = TextureManager::Instance().getTextureSize("obstacle");
+	auto size = TextureManager::Instance().getTextureSize(m_textureHandle);
 	setWidth(size.x);
 	setHeight(size.y);
 
@@ -23,7 +23,7 @@ Obstacle::~Obstacle()
 
 void Obstacle::draw()
 {
-	TextureManager::Instance().draw("obstacle",
+	TextureManager::Instance().draw(m_textureHandle,
 		getTransform()->position.x, getTransform()->position.y, this, 0, 128, true);
 }
 
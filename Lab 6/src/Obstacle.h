@@ -2,6 +2,7 @@
 #ifndef __OBSTACLE__
 #define __OBSTACLE__
 #include "DisplayObject.h"
+#include "TextureHandle.h"
 
 class Obstacle final : public DisplayObject
 {
@@ -17,7 +18,7 @@ public:
 	void update() override;
 	void clean() override;
 private:
-	
+	TextureHandle m_textureHandle;
 };
 
 #endif /* defined (__OBSTACLE__) */
\ No newline at end of file
@@ -2,22 +2,29 @@
 #ifndef __PATH_NODE__
 #define __PATH_NODE__
 
-#include "Agent.h"
+#include <cstdint>
+#include <glm/vec2.hpp>
 
-class PathNode : public Agent
+// bit flags stored in PathNode::flags
+enum PathNodeFlag : uint8_t
 {
-public:
-	// Constructor
-	PathNode();
-	
-	// Destructor
-	~PathNode();
-	
-	// Life Cycle Functions
-	void draw() override;
-	void update() override;
-	void clean() override;
-private:
+	NODE_ENABLED = 1 << 0, // node is not blocked by an obstacle
+	NODE_LOS_TARGET = 1 << 1, // node can see the target
+	NODE_LOS_SPACE_SHIP = 1 << 2 // node can see the space ship
 };
 
-#endif /* defined (__PATH_NODE__)*/
\ No newline at end of file
+// plain grid node record - kept in a contiguous array by the scene and drawn by PathNodeRenderer
+struct PathNode
+{
+	static constexpr int SIZE = 10; // width and height of the debug rectangle
+
+	glm::vec2 position;
+	float LOSDistance;
+	uint8_t flags;
+
+	bool isEnabled() const { return flags & NODE_ENABLED; }
+	bool hasFlag(const PathNodeFlag flag) const { return flags & flag; }
+	void setFlag(const PathNodeFlag flag, const bool state) { flags = state ? (flags | flag) : (flags & ~flag); }
+};
+
+#endif /* defined (__PATH_NODE__)*/
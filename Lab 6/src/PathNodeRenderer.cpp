@@ -0,0 +1,57 @@
+#include "PathNodeRenderer.h"
+
+#include "Camera.h"
+#include "Util.h"
+
+PathNodeRenderer::PathNodeRenderer(const std::vector<PathNode>* grid) : m_pGrid(grid)
+{
+	setWidth(0);
+	setHeight(0);
+	getTransform()->position = glm::vec2(0.0f, 0.0f);
+	getRigidBody()->isColliding = false;
+	setType(PATH_NODE);
+}
+
+PathNodeRenderer::~PathNodeRenderer()
+= default;
+
+void PathNodeRenderer::draw()
+{
+	const auto half_size = glm::vec2(PathNode::SIZE * 0.5f, PathNode::SIZE * 0.5f);
+	const auto camera = Renderer::Instance().getCamera();
+
+	for (const auto& path_node : *m_pGrid)
+	{
+		if (!path_node.isEnabled()) continue;
+
+		// the renderer is never culled as a whole, so cull node by node
+		if (camera != nullptr && !camera->isVisible({ path_node.position - half_size, path_node.position + half_size })) continue;
+
+		// colour matches the LOS colours used by the agents
+		const auto sees_target = path_node.hasFlag(NODE_LOS_TARGET);
+		const auto sees_space_ship = path_node.hasFlag(NODE_LOS_SPACE_SHIP);
+		glm::vec4 colour = glm::vec4(1, 0, 0, 1); // no LOS
+		if (sees_target && sees_space_ship)
+		{
+			colour = glm::vec4(0, 1, 1, 1);
+		}
+		else if (sees_target)
+		{
+			colour = glm::vec4(0, 1, 0, 1);
+		}
+		else if (sees_space_ship)
+		{
+			colour = glm::vec4(0, 0, 1, 1);
+		}
+
+		Util::DrawRect(path_node.position - half_size, PathNode::SIZE, PathNode::SIZE, colour);
+	}
+}
+
+void PathNodeRenderer::update()
+{
+}
+
+void PathNodeRenderer::clean()
+{
+}
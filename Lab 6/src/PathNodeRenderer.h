@@ -0,0 +1,27 @@
+#pragma once
+#ifndef __PATH_NODE_RENDERER__
+#define __PATH_NODE_RENDERER__
+
+#include <vector>
+#include "DisplayObject.h"
+#include "PathNode.h"
+
+// draws the debug overlay for a grid of PathNodes owned by the scene
+class PathNodeRenderer final : public DisplayObject
+{
+public:
+	// Constructor
+	PathNodeRenderer(const std::vector<PathNode>* grid);
+
+	// Destructor
+	~PathNodeRenderer();
+
+	// Life Cycle Functions
+	void draw() override;
+	void update() override;
+	void clean() override;
+private:
+	const std::vector<PathNode>* m_pGrid;
+};
+
+#endif /* defined (__PATH_NODE_RENDERER__)*/
@@ -10,6 +10,7 @@
 #include "Renderer.h"
 #include "Util.h"
 #include "Config.h"
+#include <algorithm>
 #include <fstream>
 
 
@@ -31,6 +32,17 @@ void PlayScene::draw()
 void PlayScene::update()
 {
 	updateDisplayList();
+
+	// keep the spatial index in step with anything that may have moved
+	m_spatialIndex.moveProxy(m_targetProxy);
+	m_spatialIndex.moveProxy(m_spaceShipProxy);
+
+	m_checkCollisions();
+	m_handleContactEvents();
+
+	m_pSpaceShip->updateWhiskers(m_pSpaceShip->getWhiskerAngle());
+	CollisionManager::whiskerCheck(m_pSpaceShip, m_spatialIndex);
+
 	m_checkAgentLOS(m_pSpaceShip, m_pTarget);
 	switch (m_LOSMode)
 	{
@@ -48,6 +60,12 @@ void PlayScene::update()
 
 void PlayScene::clean()
 {
+	m_grid.clear();
+	m_nodePositions.clear();
+	m_broadphase.clear();
+	m_contacts.clear();
+	m_spatialIndex.clear();
+	m_obstacleProxies.clear();
 	removeAllChildren();
 }
 
@@ -76,6 +94,25 @@ void PlayScene::start()
 	// Set GUI Title
 	m_guiTitle = "Play Scene";
 
+	// obstacles and the path node grid only change when edited or when LOS changes
+	setLayerStatic(OBSTACLE_LAYER, true);
+	setLayerStatic(GRID_LAYER, true);
+
+	// everything the scene loads below shares one atlas
+	TextureManager::Instance().beginAtlas("play_scene");
+
+	// the tile map fills the same cells as the path node grid
+	m_pBackground = create<TileMapLayer>("../Assets/data/background.csv", "../Assets/sprites/background.json",
+		"../Assets/sprites/background.png", "background", Config::TILE_SIZE);
+	addChild(m_pBackground, BACKGROUND_LAYER);
+
+	m_pForeground = create<TileMapLayer>("../Assets/data/foreground.csv", "../Assets/sprites/foreground.json",
+		"../Assets/sprites/foreground.png", "foreground", Config::TILE_SIZE);
+	addChild(m_pForeground, FOREGROUND_LAYER);
+
+	m_isTileMapVisible = true;
+	m_toggleTileMap(m_isTileMapVisible);
+
 	// Create new obstacles from a file
 	m_createObstaclesFromFile();
 
@@ -90,13 +127,32 @@ void PlayScene::start()
 	m_buildGrid();
 	m_toggleGrid(m_isGridEnabled);
 
-	m_pTarget = new Target();
+	m_pTarget = create<Target>();
 	m_pTarget->getTransform()->position = glm::vec2(600.0f, 300.0f);
-	addChild(m_pTarget, 2);
+	addChild(m_pTarget, TARGET_LAYER);
 
-	m_pSpaceShip = new SpaceShip();
+	m_pSpaceShip = create<SpaceShip>();
 	m_pSpaceShip->getTransform()->position = glm::vec2(150.0f, 300.0f);
-	addChild(m_pSpaceShip, 3);
+	addChild(m_pSpaceShip, SPACE_SHIP_LAYER);
+
+	TextureManager::Instance().endAtlas();
+
+	// register everything that can collide with the broadphase
+	for (auto obstacle : m_pObstacles)
+	{
+		m_broadphase.addObject(obstacle);
+	}
+	m_broadphase.addObject(m_pTarget);
+	m_broadphase.addObject(m_pSpaceShip);
+
+	// and with the spatial index used by the LOS checks
+	for (auto obstacle : m_pObstacles)
+	{
+		m_obstacleProxies.push_back(m_spatialIndex.createProxy(obstacle));
+	}
+	m_targetProxy = m_spatialIndex.createProxy(m_pTarget);
+	m_spaceShipProxy = m_spatialIndex.createProxy(m_pSpaceShip);
+	m_pSpaceShip->setSpatialIndex(&m_spatialIndex);
 
 	// preload sounds
 	SoundManager::Instance().load("../Assets/audio/yay.ogg", "yay", SOUND_SFX);
@@ -105,129 +161,301 @@ void PlayScene::start()
 	ImGuiWindowFrame::Instance().setGUIFunction(std::bind(&PlayScene::GUI_Function, this));
 }
 
+void PlayScene::onRenderTargetsReset()
+{
+	Scene::onRenderTargetsReset();
+
+	// the tile maps bake their chunks outside the layer caches
+	m_pBackground->invalidateChunks();
+	m_pForeground->invalidateChunks();
+}
+
 void PlayScene::m_buildGrid()
 {
 	const auto tile_size = Config::TILE_SIZE;
 	auto offset = glm::vec2(Config::TILE_SIZE * 0.5f, Config::TILE_SIZE * 0.5f);
 
-	m_clearNodes(); // we will need clear nodes because we will rebuild/redraw the grid if we move an obstacle
-
-	// lay out a grid of path_nodes
-	for (int row = 0; row < Config::ROW_NUM; ++row)
+	// lay out the pool of path_nodes once - after that nodes are only enabled or disabled
+	if (m_grid.empty())
 	{
-		for (int col = 0; col < Config::COL_NUM; ++col)
+		m_grid.reserve(Config::ROW_NUM * Config::COL_NUM);
+		for (int row = 0; row < Config::ROW_NUM; ++row)
 		{
-			PathNode* path_node = new PathNode();
-			path_node->getTransform()->position = glm::vec2((col * tile_size) + offset.x, (row * tile_size) + offset.y);
-			bool keep_node = true;
-			for (auto obstacle : m_pObstacles)
-			{
-				// determine which path_nodes to keep
-				if (CollisionManager::AABBCheckWithBuffer(path_node, obstacle, m_obstacleBuffer))
-				{
-					keep_node = false;
-				}
-			}
-			if (keep_node)
-			{
-				addChild(path_node, 1);
-				m_pGrid.push_back(path_node);
-			}
-			else
+			for (int col = 0; col < Config::COL_NUM; ++col)
 			{
-				delete path_node;
+				PathNode path_node{};
+				path_node.position = glm::vec2((col * tile_size) + offset.x, (row * tile_size) + offset.y);
+				path_node.LOSDistance = static_cast<float>(m_pathNodeLOSDistance);
+				m_grid.push_back(path_node);
 			}
 		}
+
+		m_nodePositions.reserve(m_grid.size());
+		for (const auto& path_node : m_grid)
+		{
+			m_nodePositions.push_back(path_node.position);
+		}
+
+		m_pGridRenderer = create<PathNodeRenderer>(&m_grid);
+		addChild(m_pGridRenderer, GRID_LAYER);
+	}
+
+	// determine which path_nodes to keep
+	for (auto& path_node : m_grid)
+	{
+		path_node.setFlag(NODE_ENABLED, !m_isNodeBlocked(path_node));
 	}
+	invalidateLayer(GRID_LAYER);
 
 	// if Grid is supposed to be hidden - make it so!
 	m_toggleGrid(m_isGridEnabled);
 }
 
-void PlayScene::m_toggleGrid(const bool state)
+void PlayScene::m_updateGridRegion(Obstacle* obstacle, const int buffer, const glm::vec2 previous_position)
 {
-	for (auto path_node : m_pGrid)
+	const auto tile_size = static_cast<float>(Config::TILE_SIZE);
+	const auto offset = tile_size * 0.5f;
+
+	// footprint of the obstacle grown by the buffer and by half a path_node on every side,
+	// covering both where it was and where it is now so the cells it left are freed again
+	const auto position = obstacle->getTransform()->position;
+	const auto half_extents = glm::vec2(obstacle->getWidth() + buffer + PathNode::SIZE, obstacle->getHeight() + buffer + PathNode::SIZE) * 0.5f;
+	const auto top_left = glm::min(previous_position, position) - half_extents;
+	const auto bottom_right = glm::max(previous_position, position) + half_extents;
+
+	// convert the footprint to a range of cells and clamp it to the grid
+	const int start_col = std::max(static_cast<int>(std::floor((top_left.x - offset) / tile_size)), 0);
+	const int end_col = std::min(static_cast<int>(std::ceil((bottom_right.x - offset) / tile_size)), Config::COL_NUM - 1);
+	const int start_row = std::max(static_cast<int>(std::floor((top_left.y - offset) / tile_size)), 0);
+	const int end_row = std::min(static_cast<int>(std::ceil((bottom_right.y - offset) / tile_size)), Config::ROW_NUM - 1);
+
+	// only the cells under the footprint can change state
+	for (int row = start_row; row <= end_row; ++row)
 	{
-		path_node->setVisible(state);
+		for (int col = start_col; col <= end_col; ++col)
+		{
+			auto& path_node = m_grid[row * Config::COL_NUM + col];
+			path_node.setFlag(NODE_ENABLED, !m_isNodeBlocked(path_node));
+		}
 	}
+	invalidateLayer(GRID_LAYER);
 }
 
-bool PlayScene::m_checkAgentLOS(Agent * agent, DisplayObject * target_object)
+bool PlayScene::m_isNodeBlocked(const PathNode& path_node) const
 {
-	bool has_LOS = false; // default - no LOS
-	agent->setHasLOS(has_LOS);
-	glm::vec4 LOSColour;
+	const auto node_half_size = glm::vec2(PathNode::SIZE * 0.5f, PathNode::SIZE * 0.5f);
+	const AABB node_bounds = { path_node.position - node_half_size, path_node.position + node_half_size };
+
+	// grow each obstacle by the buffer the same way CollisionManager::AABBCheckWithBuffer does
+	const auto lower_buffer = glm::vec2(m_obstacleBuffer / 2, m_obstacleBuffer / 2);
+	const auto upper_buffer = glm::vec2(m_obstacleBuffer, m_obstacleBuffer) - lower_buffer;
 
-	// if ship to target distance is less than or equal to LOS Distance
-	const auto AgentToTargetDistance = Util::getClosestEdge(agent->getTransform()->position, target_object);
-	if (AgentToTargetDistance <= agent->getLOSDistance()) // we are in range
+	for (auto obstacle : m_pObstacles)
 	{
-		std::vector<DisplayObject*> contact_list;
-		for (auto display_object : getDisplayList())
+		auto obstacle_bounds = AABBTree::computeAABB(obstacle);
+		obstacle_bounds.lowerBound -= lower_buffer;
+		obstacle_bounds.upperBound += upper_buffer;
+
+		if (node_bounds.overlaps(obstacle_bounds))
 		{
-			// check if the display_object is closer to the spaceship than the target
-			const auto AgentToObjectDistance = Util::getClosestEdge(agent->getTransform()->position, display_object);
-			if (AgentToObjectDistance > AgentToTargetDistance) continue;
-			if ((display_object->getType() != AGENT) && (display_object->getType() != PATH_NODE) && (display_object->getType() != TARGET))
-			{
-				contact_list.push_back(display_object);
-			}
+			return true;
 		}
+	}
+	return false;
+}
+
+void PlayScene::m_toggleGrid(const bool state)
+{
+	m_pGridRenderer->setVisible(state);
+}
 
-		const glm::vec2 agentEndPoint = agent->getTransform()->position + agent->getCurrentDirection() * agent->getLOSDistance();
-		has_LOS = CollisionManager::LOSCheck(agent, agentEndPoint, contact_list, target_object);
+void PlayScene::m_toggleTileMap(const bool state)
+{
+	m_pBackground->setVisible(state);
+	m_pForeground->setVisible(state);
+}
 
-		LOSColour = (target_object->getType() == AGENT) ? glm::vec4(0, 0, 1, 1) : glm::vec4(0, 1, 0, 1);
-		agent->setHasLOS(has_LOS, LOSColour);
+bool PlayScene::m_checkLOS(const glm::vec2 start_point, const glm::vec2 direction, const float LOS_distance, DisplayObject* target_object)
+{
+	// if start to target distance is less than or equal to LOS Distance
+	const auto StartToTargetSquaredDistance = Util::getClosestEdgeSquared(start_point, target_object);
+	if (StartToTargetSquaredDistance > LOS_distance * LOS_distance) // we are out of range
+	{
+		return false;
 	}
+
+	const glm::vec2 end_point = start_point + direction * LOS_distance;
+	return CollisionManager::LOSCheck(start_point, end_point, m_spatialIndex, target_object);
+}
+
+bool PlayScene::m_checkAgentLOS(Agent * agent, DisplayObject * target_object)
+{
+	const bool has_LOS = m_checkLOS(agent->getTransform()->position, agent->getCurrentDirection(), agent->getLOSDistance(), target_object);
+
+	const glm::vec4 LOSColour = (target_object->getType() == AGENT) ? glm::vec4(0, 0, 1, 1) : glm::vec4(0, 1, 0, 1);
+	agent->setHasLOS(has_LOS, LOSColour);
 	return has_LOS;
 }
 
-bool PlayScene::m_checkPathNodeLOS(PathNode * path_node, DisplayObject * target_object)
+bool PlayScene::m_checkPathNodeLOS(const PathNode& path_node, const float squared_distance, DisplayObject * target_object)
 {
+	// squared_distance comes from m_computeNodeDistances, so only nodes in range cast a ray
+	if (squared_distance > path_node.LOSDistance * path_node.LOSDistance)
+	{
+		return false;
+	}
+
 	// check angle to target so we can still use LOS distance for path_nodes
-	const auto target_direction = target_object->getTransform()->position - path_node->getTransform()->position;
+	const auto target_direction = target_object->getTransform()->position - path_node.position;
 	const auto normalized_direction = Util::normalize(target_direction);
-	path_node->setCurrentDirection(normalized_direction);
-	return m_checkAgentLOS(path_node, target_object);
+	const glm::vec2 end_point = path_node.position + normalized_direction * path_node.LOSDistance;
+	return CollisionManager::LOSCheck(path_node.position, end_point, m_spatialIndex, target_object);
+}
+
+// same distance as Util::getClosestEdgeSquared, measured from all the nodes at once
+void PlayScene::m_computeNodeDistances(DisplayObject* target_object, std::vector<float>& squared_distances)
+{
+	const auto count = static_cast<int>(m_nodePositions.size());
+	const auto half_width = target_object->getWidth() * 0.5f;
+	const auto half_height = target_object->getHeight() * 0.5f;
+	const auto centre = target_object->getTransform()->position;
+
+	const glm::vec2 sides[4] = { { centre.x, centre.y - half_height }, // top
+								 { centre.x, centre.y + half_height }, // bottom
+								 { centre.x - half_width, centre.y }, // left
+								 { centre.x + half_width, centre.y } }; // right
+
+	squared_distances.resize(count);
+	m_edgeSquaredDistances.resize(count);
+	CollisionManager::squaredDistances(sides[0], m_nodePositions.data(), count, squared_distances.data());
+	for (auto side = 1; side < 4; ++side)
+	{
+		CollisionManager::squaredDistances(sides[side], m_nodePositions.data(), count, m_edgeSquaredDistances.data());
+		for (auto i = 0; i < count; ++i)
+		{
+			squared_distances[i] = std::min(squared_distances[i], m_edgeSquaredDistances[i]);
+		}
+	}
 }
 
 void PlayScene::m_checkAllNodesWithTarget(DisplayObject * target_object)
 {
-	for (auto path_node : m_pGrid)
+	m_computeNodeDistances(target_object, m_targetSquaredDistances);
+
+	auto grid_changed = false;
+	for (size_t i = 0; i < m_grid.size(); ++i)
 	{
-		m_checkPathNodeLOS(path_node, target_object);
+		auto& path_node = m_grid[i];
+		if (!path_node.isEnabled()) continue;
+		const auto previous_flags = path_node.flags;
+		const bool has_LOS = m_checkPathNodeLOS(path_node, m_targetSquaredDistances[i], target_object);
+		path_node.setFlag(NODE_LOS_TARGET, (target_object == m_pTarget) && has_LOS);
+		path_node.setFlag(NODE_LOS_SPACE_SHIP, (target_object == m_pSpaceShip) && has_LOS);
+		grid_changed |= path_node.flags != previous_flags;
+	}
+
+	// the cached grid only needs redrawing when a node changed colour
+	if (grid_changed)
+	{
+		invalidateLayer(GRID_LAYER);
 	}
 }
 
 void PlayScene::m_checkAllNodesWithBoth()
 {
-	for (auto path_node : m_pGrid)
+	m_computeNodeDistances(m_pSpaceShip, m_spaceShipSquaredDistances);
+	m_computeNodeDistances(m_pTarget, m_targetSquaredDistances);
+
+	auto grid_changed = false;
+	for (size_t i = 0; i < m_grid.size(); ++i)
+	{
+		auto& path_node = m_grid[i];
+		if (!path_node.isEnabled()) continue;
+		const auto previous_flags = path_node.flags;
+		bool LOSWithSpaceShip = m_checkPathNodeLOS(path_node, m_spaceShipSquaredDistances[i], m_pSpaceShip);
+		bool LOSWithTarget = m_checkPathNodeLOS(path_node, m_targetSquaredDistances[i], m_pTarget);
+
+		// only nodes that see both are highlighted
+		path_node.setFlag(NODE_LOS_TARGET, LOSWithSpaceShip && LOSWithTarget);
+		path_node.setFlag(NODE_LOS_SPACE_SHIP, LOSWithSpaceShip && LOSWithTarget);
+		grid_changed |= path_node.flags != previous_flags;
+	}
+
+	if (grid_changed)
 	{
-		bool LOSWithSpaceShip = m_checkPathNodeLOS(path_node, m_pSpaceShip);
-		bool LOSWithTarget = m_checkPathNodeLOS(path_node, m_pTarget);
-		path_node->setHasLOS(LOSWithSpaceShip && LOSWithTarget, glm::vec4(0, 1, 1, 1));
+		invalidateLayer(GRID_LAYER);
 	}
 }
 
 void PlayScene::m_setPathNodeLOSDistance(const int dist)
 {
-	for (auto path_node : m_pGrid)
+	for (auto& path_node : m_grid)
+	{
+		path_node.LOSDistance = static_cast<float>(dist);
+	}
+}
+
+void PlayScene::m_checkCollisions()
+{
+	m_broadphase.update();
+	m_narrowPhase.clear();
+	m_batchedPairs.clear();
+
+	// narrow phase only runs on the candidate pairs the broadphase found
+	for (const auto& candidate_pair : m_broadphase.getCandidatePairs())
+	{
+		if (candidate_pair.first != m_pSpaceShip && candidate_pair.second != m_pSpaceShip) continue;
+
+		// oriented boxes need the SAT test, every other shape is checked by its bounds in the batch
+		if (candidate_pair.first->getCollisionShape() == ORIENTED_RECTANGLE || candidate_pair.second->getCollisionShape() == ORIENTED_RECTANGLE)
+		{
+			if (CollisionManager::shapeCheck(candidate_pair.first, candidate_pair.second))
+			{
+				m_contacts.addContact(candidate_pair.first, candidate_pair.second);
+			}
+			continue;
+		}
+
+		m_narrowPhase.addAABBPair(candidate_pair.first->getBounds(), candidate_pair.second->getBounds());
+		m_batchedPairs.push_back(candidate_pair);
+	}
+
+	m_narrowPhase.update();
+	for (const auto hit : m_narrowPhase.getAABBHits())
 	{
-		path_node->setLOSDistance(static_cast<float>(dist));
+		m_contacts.addContact(m_batchedPairs[hit].first, m_batchedPairs[hit].second);
 	}
+
+	m_contacts.update();
 }
 
-void PlayScene::m_clearNodes()
+void PlayScene::m_handleContactEvents()
 {
-	m_pGrid.clear();
-	for (auto display_object : getDisplayList())
+	for (const auto& contact_event : m_contacts.getEvents())
 	{
-		if (display_object->getType() == PATH_NODE)
+		// audio and logging only react to new contacts
+		if (contact_event.type != CONTACT_BEGIN) continue;
+
+		const auto other = (contact_event.first == m_pSpaceShip) ? contact_event.second : contact_event.first;
+		switch (other->getType())
 		{
-			removeChild(display_object);
+		case TARGET:
+			std::cout << "Collision with Target!" << std::endl;
+			SoundManager::Instance().playSound("yay", 0);
+			break;
+		case OBSTACLE:
+			std::cout << "Collision with Obstacle!" << std::endl;
+			SoundManager::Instance().playSound("thunder", 0);
+			break;
+		default:
+			break;
 		}
 	}
+
+	// the ship is only colliding while at least one contact is still active
+	const auto& events = m_contacts.getEvents();
+	m_pSpaceShip->getRigidBody()->isColliding = std::any_of(events.begin(), events.end(),
+		[](const ContactEvent& contact_event) { return contact_event.type != CONTACT_END; });
 }
 
 void PlayScene::m_createObstaclesFromFile()
@@ -236,13 +464,13 @@ void PlayScene::m_createObstaclesFromFile()
 	while (!inFile.eof())
 	{
 		std::cout << "Obstacle" << std::endl;
-		Obstacle* obstacle = new Obstacle();
+		Obstacle* obstacle = create<Obstacle>();
 		float x, y, w, h; // same way the file is organized
 		inFile >> x >> y >> w >> h; // read data from line in the file
 		obstacle->getTransform()->position = glm::vec2(x, y);
 		obstacle->setWidth(w);
 		obstacle->setHeight(h);
-		addChild(obstacle, 0);
+		addChild(obstacle, OBSTACLE_LAYER);
 		m_pObstacles.push_back(obstacle);
 	}
 	inFile.close();
@@ -274,6 +502,11 @@ void PlayScene::GUI_Function()
 		m_toggleGrid(m_isGridEnabled);
 	}
 
+	if (ImGui::Checkbox("Toggle Tile Map", &m_isTileMapVisible))
+	{
+		m_toggleTileMap(m_isTileMapVisible);
+	}
+
 	ImGui::Separator();
 	if (ImGui::Button("Node LOS Target", { 300, 20 }))
 	{
@@ -351,17 +584,26 @@ void PlayScene::GUI_Function()
 		std::string label = "Obstacle" + std::to_string(i + 1) + " Position";
 		if (ImGui::SliderInt2(label.c_str(), obstaclePosition, 0, 800))
 		{
+			// move first, then refresh the cells the obstacle left and the cells it moved onto in one pass
+			const auto previous_position = m_pObstacles[i]->getTransform()->position;
 			m_pObstacles[i]->getTransform()->position.x = obstaclePosition[0];
 			m_pObstacles[i]->getTransform()->position.y = obstaclePosition[1];
-			m_buildGrid();
+			m_updateGridRegion(m_pObstacles[i], m_obstacleBuffer, previous_position);
+			m_spatialIndex.moveProxy(m_obstacleProxies[i]);
+			invalidateLayer(OBSTACLE_LAYER);
 		}
 	}
 
 	ImGui::Separator();
 
+	const auto previous_buffer = m_obstacleBuffer;
 	if (ImGui::SliderInt("Obstacle Buffer", &m_obstacleBuffer, 0, 100))
 	{
-		m_buildGrid();
+		// the larger of the two footprints covers every cell that can change
+		for (auto obstacle : m_pObstacles)
+		{
+			m_updateGridRegion(obstacle, std::max(previous_buffer, m_obstacleBuffer), obstacle->getTransform()->position);
+		}
 	}
 
 	ImGui::End();
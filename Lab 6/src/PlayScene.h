@@ -9,6 +9,12 @@
 #include "SpaceShip.h"
 #include "Obstacle.h"
 #include "PathNode.h"
+#include "PathNodeRenderer.h"
+#include "TileMapLayer.h"
+#include "SweepAndPrune.h"
+#include "AABBTree.h"
+#include "ContactTracker.h"
+#include "NarrowPhaseBatch.h"
 
 class PlayScene : public Scene
 {
@@ -22,6 +28,7 @@ public:
 	virtual void clean() override;
 	virtual void handleEvents() override;
 	virtual void start() override;
+	virtual void onRenderTargetsReset() override;
 private:
 	// IMGUI Function
 	void GUI_Function();
@@ -33,22 +40,58 @@ private:
 	Target* m_pTarget;
 	SpaceShip* m_pSpaceShip;
 
+	// tile map layers bake their own chunks, layers that rarely change are drawn from a cached texture
+	static constexpr uint32_t BACKGROUND_LAYER = 0;
+	static constexpr uint32_t FOREGROUND_LAYER = 1;
+	static constexpr uint32_t OBSTACLE_LAYER = 2;
+	static constexpr uint32_t GRID_LAYER = 3;
+	static constexpr uint32_t TARGET_LAYER = 4;
+	static constexpr uint32_t SPACE_SHIP_LAYER = 5;
+
+	TileMapLayer* m_pBackground;
+	TileMapLayer* m_pForeground;
+	bool m_isTileMapVisible;
+	void m_toggleTileMap(bool state);
+
 	// Create our Division Scheme (Grid of PathNodes)
-	std::vector<PathNode*> m_pGrid;
+	std::vector<PathNode> m_grid; // one node per cell, indexed by row * COL_NUM + col
+	PathNodeRenderer* m_pGridRenderer;
 	std::vector<Obstacle*> m_pObstacles;
 
 	void m_buildGrid();
+	// re-tests the cells under the obstacle's footprint at previous_position and at its current position
+	void m_updateGridRegion(Obstacle* obstacle, int buffer, glm::vec2 previous_position);
+	bool m_isNodeBlocked(const PathNode& path_node) const;
 	void m_toggleGrid(bool state);
+	bool m_checkLOS(glm::vec2 start_point, glm::vec2 direction, float LOS_distance, DisplayObject* target_object);
 	bool m_checkAgentLOS(Agent* agent, DisplayObject* target_object);
-	bool m_checkPathNodeLOS(PathNode* path_node, DisplayObject* target_object);
+	bool m_checkPathNodeLOS(const PathNode& path_node, float squared_distance, DisplayObject* target_object);
+	void m_computeNodeDistances(DisplayObject* target_object, std::vector<float>& squared_distances);
 	void m_checkAllNodesWithTarget(DisplayObject* target_object);
 	void m_checkAllNodesWithBoth();
+	std::vector<glm::vec2> m_nodePositions; // parallel to m_grid, for the batched distance test
+	std::vector<float> m_edgeSquaredDistances; // scratch for m_computeNodeDistances
+	std::vector<float> m_targetSquaredDistances; // squared distance from each node to the target
+	std::vector<float> m_spaceShipSquaredDistances;
 	void m_setPathNodeLOSDistance(int dist);
 	int m_LOSMode; // 0 = nodes visible to target, 1 = nodes visible to player, 2 = nodes visible to both
 
-	void m_clearNodes();
 	void m_createObstaclesFromFile();
 
+	// Collision
+	SweepAndPrune m_broadphase;
+	NarrowPhaseBatch m_narrowPhase; // axis aligned candidate pairs are tested together
+	std::vector<SweepAndPrune::CandidatePair> m_batchedPairs; // parallel to the batch's AABB pairs
+	ContactTracker m_contacts;
+	void m_checkCollisions();
+	void m_handleContactEvents();
+
+	// Spatial index for LOS and nearest object queries
+	AABBTree m_spatialIndex;
+	std::vector<int> m_obstacleProxies; // parallel to m_pObstacles
+	int m_targetProxy;
+	int m_spaceShipProxy;
+
 	int m_obstacleBuffer;
 	int m_pathNodeLOSDistance;
 
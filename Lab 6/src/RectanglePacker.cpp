@@ -0,0 +1,77 @@
+#include "RectanglePacker.h"
+
+#include <algorithm>
+
+RectanglePacker::RectanglePacker(const int page_width, const int page_height, const int padding)
+	: m_pageWidth(page_width), m_pageHeight(page_height), m_padding(padding)
+{
+}
+
+RectanglePacker::~RectanglePacker()
+= default;
+
+bool RectanglePacker::pack(const int width, const int height, int& page, SDL_Rect& rect)
+{
+	if (width > m_pageWidth || height > m_pageHeight)
+	{
+		return false;
+	}
+
+	for (auto i = 0; i < static_cast<int>(m_pages.size()); ++i)
+	{
+		if (m_packOnPage(m_pages[i], width, height, rect))
+		{
+			page = i;
+			return true;
+		}
+	}
+
+	m_pages.push_back({ {}, 0, { 0, 0 } });
+	page = static_cast<int>(m_pages.size()) - 1;
+	return m_packOnPage(m_pages.back(), width, height, rect);
+}
+
+int RectanglePacker::numberOfPages() const
+{
+	return static_cast<int>(m_pages.size());
+}
+
+SDL_Point RectanglePacker::getUsedSize(const int page) const
+{
+	return m_pages[page].usedSize;
+}
+
+bool RectanglePacker::m_packOnPage(Page& page, const int width, const int height, SDL_Rect& rect) const
+{
+	// padding keeps filtered samples from bleeding in from the neighbouring rectangles
+	const auto padded_width = width + m_padding;
+	const auto padded_height = height + m_padding;
+
+	Shelf* target = nullptr;
+	for (auto& shelf : page.shelves)
+	{
+		if (padded_height <= shelf.height && shelf.nextX + width <= m_pageWidth)
+		{
+			target = &shelf;
+			break;
+		}
+	}
+
+	if (target == nullptr)
+	{
+		if (page.nextShelfY + height > m_pageHeight)
+		{
+			return false;
+		}
+		page.shelves.push_back({ page.nextShelfY, padded_height, 0 });
+		page.nextShelfY += padded_height;
+		target = &page.shelves.back();
+	}
+
+	rect = { target->nextX, target->y, width, height };
+	target->nextX += padded_width;
+
+	page.usedSize.x = std::max(page.usedSize.x, rect.x + width);
+	page.usedSize.y = std::max(page.usedSize.y, rect.y + height);
+	return true;
+}
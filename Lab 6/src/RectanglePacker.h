@@ -0,0 +1,49 @@
+#pragma once
+#ifndef __RECTANGLE_PACKER__
+#define __RECTANGLE_PACKER__
+
+#include <vector>
+#include <SDL.h>
+
+/*
+ * Shelf packer used to build texture atlases. Rectangles are placed left to right on shelves
+ * stacked top to bottom, and a new page is opened when a rectangle fits on none of them.
+ * Packing in order of decreasing height keeps the shelves tight.
+ */
+class RectanglePacker
+{
+public:
+	RectanglePacker(int page_width, int page_height, int padding = 1);
+	~RectanglePacker();
+
+	// returns false if the rectangle is larger than a page
+	bool pack(int width, int height, int& page, SDL_Rect& rect);
+
+	int numberOfPages() const;
+	// the area of a page actually covered by rectangles - atlases are created at this size
+	SDL_Point getUsedSize(int page) const;
+
+private:
+	struct Shelf
+	{
+		int y;
+		int height;
+		int nextX;
+	};
+
+	struct Page
+	{
+		std::vector<Shelf> shelves;
+		int nextShelfY;
+		SDL_Point usedSize;
+	};
+
+	bool m_packOnPage(Page& page, int width, int height, SDL_Rect& rect) const;
+
+	int m_pageWidth;
+	int m_pageHeight;
+	int m_padding;
+	std::vector<Page> m_pages;
+};
+
+#endif /* defined (__RECTANGLE_PACKER__) */
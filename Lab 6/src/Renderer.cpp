@@ -1,6 +1,7 @@
 #include "Renderer.h"
 
 #include <utility>
+#include "Camera.h"
 
 SDL_Renderer* Renderer::getRenderer()
 {
@@ -12,8 +13,30 @@ void Renderer::setRenderer(std::shared_ptr<SDL_Renderer> renderer)
 	m_pRenderer = std::move(renderer);
 }
 
+const Camera* Renderer::getCamera() const
+{
+	return m_pCamera;
+}
+
+void Renderer::setCamera(const Camera* camera)
+{
+	m_pCamera = camera;
+}
+
+glm::vec2 Renderer::worldToScreen(const glm::vec2 world_point) const
+{
+	return (m_pCamera != nullptr) ? m_pCamera->worldToScreen(world_point) : world_point;
+}
+
+float Renderer::getZoom() const
+{
+	return (m_pCamera != nullptr) ? m_pCamera->getZoom() : 1.0f;
+}
+
 Renderer::Renderer()
-= default;
+	: m_pCamera(nullptr)
+{
+}
 
 Renderer::~Renderer()
 = default;
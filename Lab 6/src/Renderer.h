@@ -2,8 +2,11 @@
 #ifndef __RENDERER__
 #define __RENDERER__
 #include <SDL.h>
+#include <glm/vec2.hpp>
 #include "Config.h"
 
+class Camera;
+
 /* Singleton */
 class Renderer
 {
@@ -18,11 +21,18 @@ public:
 	SDL_Renderer* getRenderer();
 	void setRenderer(std::shared_ptr<SDL_Renderer> renderer);
 
+	// camera the draw helpers map world positions through - nullptr draws in screen space
+	const Camera* getCamera() const;
+	void setCamera(const Camera* camera);
+	glm::vec2 worldToScreen(glm::vec2 world_point) const;
+	float getZoom() const;
+
 private:
 	Renderer();
 	~Renderer();
 
 	std::shared_ptr<SDL_Renderer> m_pRenderer;
+	const Camera* m_pCamera;
 };
 
 #endif /* defined (__RENDERER__) */
\ No newline at end of file
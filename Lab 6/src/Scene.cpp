@@ -2,7 +2,10 @@
 
 #include <algorithm>
 
+#include "DebugDraw.h"
 #include "DisplayObject.h"
+#include "Renderer.h"
+#include "SpriteBatch.h"
 
 Scene::Scene()
 = default;
@@ -10,6 +13,11 @@ Scene::Scene()
 Scene::~Scene()
 {
 	removeAllChildren();
+
+	if (Renderer::Instance().getCamera() == &m_camera)
+	{
+		Renderer::Instance().setCamera(nullptr);
+	}
 }
 
 
@@ -28,82 +36,295 @@ void Scene::addChild(DisplayObject * child, uint32_t layer_index, std::optional<
 	}
 	child->setLayerIndex(layer_index, index);
 	child->m_pParentScene = this;
+	child->m_displayListIndex = static_cast<int>(m_displayList.size());
 	m_displayList.push_back(child);
+	m_displayListDirty = true;
+	m_addToBucket(child);
+	invalidateLayer(layer_index);
 }
 
 void Scene::removeChild(DisplayObject * child)
 {
-	delete child;
-	m_displayList.erase(std::remove(m_displayList.begin(), m_displayList.end(), child), m_displayList.end());
+	// ignore children of other scenes and children that were already removed
+	if (child == nullptr || child->m_pParentScene != this || child->m_displayListIndex == -1) return;
+
+	m_detachChild(child);
 }
 
 void Scene::removeAllChildren()
 {
 	for (auto& count : m_displayList)
 	{
-		delete count;
+		m_destroyChild(count);
 		count = nullptr;
 	}
 
 	m_displayList.clear();
+	for (auto& bucket : m_typeBuckets)
+	{
+		bucket.clear();
+	}
+	m_numberOfEnabledChildren = 0;
+	m_displayListDirty = false;
+	m_layerCaches.clear();
+
+	// the removed children are no longer in the display list, so delete them separately
+	for (auto& child : m_removedChildren)
+	{
+		m_destroyChild(child);
+	}
+	m_removedChildren.clear();
+
+	// every arena object is gone now, so the whole arena goes back in one go
+	m_arena.release();
 }
 
 
 int Scene::numberOfChildren() const
 {
-	return m_displayList.size();
+	return static_cast<int>(m_displayList.size() - m_removedChildren.size());
 }
 
 bool Scene::sortObjects(DisplayObject * left, DisplayObject * right)
 {
-	/*
-	 * First check if they have the same enabled status, if they have the same enabled status,
-	 * we first check to see if they're on the same layer, if they are then we sort by layer order index,
-	 * otherwise we simply sort by layer index
-	 * If they do not have the same enabled status, one is true and one is false, so if left is true, it gets
-	 * sorted first, otherwise right is true and it goes first
-	 * This will effectively sort by layer indices, and move disabled elements to the end of the list
-	 */
+	// sort by layer index, then by layer order index within the same layer
 	return
-		(left->isEnabled() == right->isEnabled()) ?
-		(left->m_layerIndex == right->m_layerIndex ?
-			left->m_layerOrderIndex < right->m_layerOrderIndex :
-			left->m_layerIndex < right->m_layerIndex) :
-		left->isEnabled();
+		(left->m_layerIndex == right->m_layerIndex) ?
+		left->m_layerOrderIndex < right->m_layerOrderIndex :
+		left->m_layerIndex < right->m_layerIndex;
+}
+
+void Scene::m_sortDisplayList()
+{
+	if (!m_displayListDirty) return;
+
+	// move disabled elements (and empty slots) to the end of the list, then only the enabled partition needs ordering
+	const auto first_disabled = std::partition(m_displayList.begin(), m_displayList.end(),
+		[](DisplayObject* display_object) { return display_object != nullptr && display_object->isEnabled(); });
+	std::sort(m_displayList.begin(), first_disabled, sortObjects);
+
+	m_numberOfEnabledChildren = first_disabled - m_displayList.begin();
+	m_displayListDirty = false;
+
+	for (size_t i = 0; i < m_displayList.size(); ++i)
+	{
+		if (m_displayList[i] != nullptr)
+		{
+			m_displayList[i]->m_displayListIndex = static_cast<int>(i);
+		}
+	}
+}
+
+void Scene::m_detachChild(DisplayObject* child)
+{
+	// leave an empty slot so nothing has to move - m_destroyRemovedChildren closes the gaps
+	m_displayList[child->m_displayListIndex] = nullptr;
+	child->m_displayListIndex = -1;
+	invalidateLayer(child->m_layerIndex);
+	m_removeFromBucket(child);
+	m_removedChildren.push_back(child);
+}
+
+void Scene::m_destroyRemovedChildren()
+{
+	if (m_removedChildren.empty()) return;
+
+	// close the gaps in one pass - the order (and so the partition) is preserved
+	size_t count = 0;
+	size_t enabled_count = 0;
+	for (size_t i = 0; i < m_displayList.size(); ++i)
+	{
+		const auto display_object = m_displayList[i];
+		if (display_object == nullptr) continue;
+
+		if (i < m_numberOfEnabledChildren)
+		{
+			++enabled_count;
+		}
+		display_object->m_displayListIndex = static_cast<int>(count);
+		m_displayList[count++] = display_object;
+	}
+	m_displayList.resize(count);
+	m_numberOfEnabledChildren = enabled_count;
+
+	for (auto& child : m_removedChildren)
+	{
+		m_destroyChild(child);
+	}
+	m_removedChildren.clear();
+}
+
+void Scene::m_destroyChild(DisplayObject* child)
+{
+	if (child == nullptr) return;
+
+	// arena objects are only destroyed - their memory is released with the arena
+	if (m_arena.owns(child))
+	{
+		child->~DisplayObject();
+	}
+	else
+	{
+		delete child;
+	}
 }
 
 void Scene::updateDisplayList()
 {
-	std::sort(m_displayList.begin(), m_displayList.end(), sortObjects);
-	for (auto& display_object : m_displayList)
+	m_sortDisplayList();
+
+	// indexed loop - objects may add children while they update
+	for (size_t i = 0; i < m_numberOfEnabledChildren; ++i)
 	{
-		if (display_object != nullptr)
+		const auto display_object = m_displayList[i];
+		if (display_object != nullptr && display_object->isEnabled())
 		{
-			if (!display_object->isEnabled())
-				break;
 			display_object->update();
 		}
 	}
+
+	// children removed while updating go now, so a scene that is never drawn (headless) doesn't keep them
+	m_destroyRemovedChildren();
 }
 
 void Scene::drawDisplayList()
 {
-	std::sort(m_displayList.begin(), m_displayList.end(), sortObjects);
-	for (auto& display_object : m_displayList)
+	m_sortDisplayList();
+
+	Renderer::Instance().setCamera(&m_camera);
+	const auto view_bounds = m_camera.getViewBounds();
+	SpriteBatch::Instance().begin();
+
+	size_t i = 0;
+	while (i < m_numberOfEnabledChildren)
 	{
-		if (display_object != nullptr)
+		const auto display_object = m_displayList[i];
+		if (display_object == nullptr)
+		{
+			++i;
+			continue;
+		}
+
+		const auto cache = m_layerCaches.find(display_object->m_layerIndex);
+		if (cache == m_layerCaches.end())
 		{
-			if (display_object->isEnabled() && display_object->isVisible())
+			m_drawChild(display_object, view_bounds);
+			++i;
+			continue;
+		}
+
+		// the layer's children are next to each other in the sorted list
+		const auto layer_index = display_object->m_layerIndex;
+		auto layer_end = i;
+		while (layer_end < m_numberOfEnabledChildren &&
+			(m_displayList[layer_end] == nullptr || m_displayList[layer_end]->m_layerIndex == layer_index))
+		{
+			++layer_end;
+		}
+
+		auto& layer_cache = cache->second;
+		if (!layer_cache.isValid(m_camera))
+		{
+			const auto capturing = layer_cache.beginCapture();
+			for (auto j = i; j < layer_end; ++j)
+			{
+				if (m_displayList[j] != nullptr)
+				{
+					m_drawChild(m_displayList[j], view_bounds);
+				}
+			}
+			if (capturing)
 			{
-				display_object->draw();
+				layer_cache.endCapture(m_camera);
 			}
+		}
 
+		if (layer_cache.isValid(m_camera))
+		{
+			layer_cache.draw();
 		}
+		i = layer_end;
 	}
 
+	SpriteBatch::Instance().end();
+	DebugDraw::Instance().flush();
+
+	// picks up anything removed after updateDisplayList, e.g. from the scene's own update or the GUI
+	m_destroyRemovedChildren();
 }
 
-std::vector<DisplayObject*> Scene::getDisplayList() const
+void Scene::m_drawChild(DisplayObject* child, const AABB& view_bounds)
+{
+	if (!child->isEnabled() || !child->isVisible()) return;
+
+	// children without a size (overlays, renderers of their own sets) are never culled
+	const auto sized = child->getWidth() > 0 && child->getHeight() > 0;
+	if (sized && !view_bounds.overlaps(child->getBounds())) return;
+
+	SpriteBatch::Instance().setLayer(child->m_layerIndex);
+	child->draw();
+}
+
+void Scene::setLayerStatic(const uint32_t layer_index, const bool state)
+{
+	if (state)
+	{
+		m_layerCaches[layer_index].invalidate();
+	}
+	else
+	{
+		m_layerCaches.erase(layer_index);
+	}
+}
+
+void Scene::invalidateLayer(const uint32_t layer_index)
+{
+	const auto cache = m_layerCaches.find(layer_index);
+	if (cache != m_layerCaches.end())
+	{
+		cache->second.invalidate();
+	}
+}
+
+void Scene::onRenderTargetsReset()
+{
+	// after a device reset the textures themselves are gone, so they are recreated rather than redrawn
+	for (auto& layer_cache : m_layerCaches)
+	{
+		layer_cache.second.release();
+	}
+}
+
+Camera& Scene::getCamera()
+{
+	return m_camera;
+}
+
+const std::vector<DisplayObject*>& Scene::getDisplayList() const
 {
 	return m_displayList;
 }
+
+const std::vector<DisplayObject*>& Scene::getChildrenOfType(const GameObjectType type) const
+{
+	return m_typeBuckets[type + 1];
+}
+
+void Scene::m_addToBucket(DisplayObject* child)
+{
+	auto& bucket = m_typeBuckets[child->getType() + 1];
+	child->m_typeBucketIndex = static_cast<int>(bucket.size());
+	bucket.push_back(child);
+}
+
+void Scene::m_removeFromBucket(DisplayObject* child)
+{
+	if (child->m_typeBucketIndex == -1) return;
+
+	// bucket order does not matter, so swap the last child into the slot
+	auto& bucket = m_typeBuckets[child->getType() + 1];
+	bucket[child->m_typeBucketIndex] = bucket.back();
+	bucket[child->m_typeBucketIndex]->m_typeBucketIndex = child->m_typeBucketIndex;
+	bucket.pop_back();
+	child->m_typeBucketIndex = -1;
+}
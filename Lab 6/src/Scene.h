@@ -2,10 +2,17 @@
 #ifndef __SCENE__
 #define __SCENE__
 
+#include <new>
+#include <unordered_map>
 #include <vector>
 #include <optional>
+#include <utility>
+#include "Camera.h"
 #include "GameObject.h"
+#include "LayerCache.h"
+#include "SceneArena.h"
 
+class DisplayObject;
 
 class Scene : public GameObject
 {
@@ -21,22 +28,99 @@ public:
 	virtual void handleEvents() = 0;
 	virtual void start() = 0;
 
+	/*
+	 * Constructs an object in the scene's arena. Pass it to addChild as usual - the scene
+	 * destroys it like any other child and the memory goes back when all children are removed.
+	 */
+	template <typename T, typename... Args>
+	T* create(Args&&... args);
+
 	void addChild(DisplayObject* child, uint32_t layer_index = 0, std::optional<uint32_t> order_index = std::nullopt);
+
+	/*
+	 * Removal is O(1) - the child's slot in the display list is cleared (it is skipped from then on)
+	 * and the child is deleted at the end of the next updateDisplayList or drawDisplayList, whichever runs first.
+	 */
 	void removeChild(DisplayObject* child);
+	// removes every child the predicate returns true for in a single pass over the display list
+	template <typename Predicate>
+	void removeChildrenIf(Predicate predicate);
 
 	void removeAllChildren();
 	int numberOfChildren() const;
 
 	void updateDisplayList();
+	// draws through the scene's camera and skips children whose bounds are outside its view
 	void drawDisplayList();
 
-	std::vector<DisplayObject*> getDisplayList() const;
+	Camera& getCamera();
+
+	/*
+	 * A static layer is drawn once into a render-target texture and copied from there until it is invalidated.
+	 * Adding, removing, enabling, showing or re-layering a child invalidates its layer automatically,
+	 * anything else that changes how the layer looks (e.g. moving a child) has to call invalidateLayer.
+	 */
+	void setLayerStatic(uint32_t layer_index, bool state);
+	void invalidateLayer(uint32_t layer_index);
+
+	// the renderer lost the contents of its render targets (SDL_RENDER_TARGETS_RESET / SDL_RENDER_DEVICE_RESET).
+	// Drops every layer cache - scenes that bake into targets of their own override this and call the base
+	virtual void onRenderTargetsReset();
+
+	// non-owning views - valid until the next addChild or removeChild, removed children show up as nullptr until the end of the frame
+	const std::vector<DisplayObject*>& getDisplayList() const;
+	const std::vector<DisplayObject*>& getChildrenOfType(GameObjectType type) const;
 
 private:
 	uint32_t m_nextLayerIndex = 0;
+
+	/*
+	 * Enabled objects sorted by layer come first, disabled objects follow in no particular order.
+	 * The list is only re-sorted when addChild, setLayerIndex or setEnabled marks it dirty.
+	 */
 	std::vector<DisplayObject*> m_displayList;
+	size_t m_numberOfEnabledChildren = 0;
+	bool m_displayListDirty = false;
+
+	// removed this frame, deleted by m_destroyRemovedChildren
+	std::vector<DisplayObject*> m_removedChildren;
+
+	// backing memory for children made with create()
+	SceneArena m_arena;
+
+	Camera m_camera;
+	std::unordered_map<uint32_t, LayerCache> m_layerCaches; // static layers only
+
+	// one bucket per GameObjectType, NONE (-1) is bucket 0
+	std::vector<DisplayObject*> m_typeBuckets[NUM_OF_TYPES + 1];
 
 	static bool sortObjects(DisplayObject* left, DisplayObject* right);
+	void m_sortDisplayList();
+	void m_detachChild(DisplayObject* child);
+	void m_destroyRemovedChildren();
+	void m_destroyChild(DisplayObject* child);
+	static void m_drawChild(DisplayObject* child, const AABB& view_bounds);
+	void m_addToBucket(DisplayObject* child);
+	void m_removeFromBucket(DisplayObject* child);
 };
 
+template <typename T, typename... Args>
+T* Scene::create(Args&&... args)
+{
+	void* memory = m_arena.allocate(sizeof(T), alignof(T));
+	return new (memory) T(std::forward<Args>(args)...);
+}
+
+template <typename Predicate>
+void Scene::removeChildrenIf(Predicate predicate)
+{
+	for (auto* child : m_displayList)
+	{
+		if (child != nullptr && predicate(child))
+		{
+			m_detachChild(child);
+		}
+	}
+}
+
 #endif /* defined (__SCENE__) */
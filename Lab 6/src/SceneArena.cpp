@@ -0,0 +1,71 @@
+#include "SceneArena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+
+SceneArena::SceneArena(const size_t block_size)
+	: m_blockSize(block_size), m_offset(0)
+{
+}
+
+SceneArena::~SceneArena()
+= default;
+
+void* SceneArena::allocate(const size_t size, const size_t alignment)
+{
+	if (!m_blocks.empty())
+	{
+		const auto& block = m_blocks.back();
+		const auto base = reinterpret_cast<std::uintptr_t>(block.memory.get());
+		const auto aligned_offset = ((base + m_offset + alignment - 1) & ~(alignment - 1)) - base;
+		if (aligned_offset + size <= block.size)
+		{
+			m_offset = aligned_offset + size;
+			return block.memory.get() + aligned_offset;
+		}
+	}
+
+	// the current block is full (or too small for this object) - start a new one
+	m_addBlock(size + alignment);
+
+	const auto& block = m_blocks.back();
+	const auto base = reinterpret_cast<std::uintptr_t>(block.memory.get());
+	const auto aligned_offset = ((base + alignment - 1) & ~(alignment - 1)) - base;
+	m_offset = aligned_offset + size;
+	return block.memory.get() + aligned_offset;
+}
+
+bool SceneArena::owns(const void* pointer) const
+{
+	const auto less = std::less<const void*>();
+	for (const auto& block : m_blocks)
+	{
+		const void* begin = block.memory.get();
+		const void* end = block.memory.get() + block.size;
+		if (!less(pointer, begin) && less(pointer, end))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void SceneArena::release()
+{
+	m_blocks.clear();
+	m_offset = 0;
+}
+
+int SceneArena::numberOfBlocks() const
+{
+	return static_cast<int>(m_blocks.size());
+}
+
+void SceneArena::m_addBlock(const size_t minimum_size)
+{
+	const auto size = std::max(m_blockSize, minimum_size);
+	// not value-initialised - every object constructed here initialises its own memory
+	m_blocks.push_back({ std::unique_ptr<std::byte[]>(new std::byte[size]), size });
+	m_offset = 0;
+}
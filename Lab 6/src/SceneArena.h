@@ -0,0 +1,51 @@
+#pragma once
+#ifndef __SCENE_ARENA__
+#define __SCENE_ARENA__
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/*
+ * Bump allocator that lives as long as a scene.
+ * Objects are placed one after another in large blocks, so a scene load costs a handful of
+ * allocations instead of one per object, and objects created together sit together in memory.
+ * Nothing is freed individually - release() drops every block at once after the objects
+ * in them have been destroyed.
+ */
+class SceneArena
+{
+public:
+	static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+	explicit SceneArena(size_t block_size = DEFAULT_BLOCK_SIZE);
+	~SceneArena();
+
+	SceneArena(const SceneArena&) = delete;
+	SceneArena& operator=(const SceneArena&) = delete;
+
+	void* allocate(size_t size, size_t alignment);
+
+	// true if pointer points into one of the arena's blocks
+	bool owns(const void* pointer) const;
+
+	// frees every block - the objects in them must already be destroyed
+	void release();
+
+	int numberOfBlocks() const;
+
+private:
+	struct Block
+	{
+		std::unique_ptr<std::byte[]> memory;
+		size_t size;
+	};
+
+	std::vector<Block> m_blocks;
+	size_t m_blockSize;
+	size_t m_offset; // first free byte in the last block
+
+	void m_addBlock(size_t minimum_size);
+};
+
+#endif /* defined (__SCENE_ARENA__) */
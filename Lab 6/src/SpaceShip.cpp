@@ -6,9 +6,12 @@
 
 SpaceShip::SpaceShip()
 {
-	TextureManager::Instance().load("../Assets/textures/ncl_small.png", "space_ship");
+	// agents move every frame, so keep their components with the other movers
+	useComponentManager();
 
-	const auto size = TextureManager::Instance().getTextureSize("space_ship");
+	m_textureHandle = TextureManager::Instance().load("../Assets/textures/ncl_small.png", "space_ship");
+
+	const auto size = TextureManager::Instance().getTextureSize(m_textureHandle);
 	setWidth(size.x);
 	setHeight(size.y);
 	getTransform()->position = glm::vec2(100.0f, 400.0f);
@@ -16,6 +19,7 @@ SpaceShip::SpaceShip()
 	getRigidBody()->velocity = glm::vec2(0, 0);
 	getRigidBody()->acceleration = glm::vec2(0, 0);
 	getRigidBody()->isColliding = false;
+	setCollisionShape(ORIENTED_RECTANGLE);
 
 	// starting motion properties
 	setCurrentHeading(0.0f); // current facing angle
@@ -40,7 +44,7 @@ void SpaceShip::draw()
 	const auto y = getTransform()->position.y;
 
 	// draw the target
-	TextureManager::Instance().draw("space_ship", x, y, getCurrentHeading(), 255, isCentered());
+	TextureManager::Instance().draw(m_textureHandle, x, y, getCurrentHeading(), 255, isCentered());
 
 	// draw LOS
 	Util::DrawLine(getTransform()->position, getTransform()->position + getCurrentDirection() * getLOSDistance(), getLOSColour());
@@ -153,7 +157,8 @@ void SpaceShip::m_move()
 	// compute the new position
 	glm::vec2 final_position = initial_position + velocity_term + acceleration_term;
 
-	getTransform()->position = final_position;
+	// sweep to the new position so high speeds cannot tunnel through thin obstacles
+	sweepMove(final_position - initial_position);
 
 	// add our acceleration to velocity
 	getRigidBody()->velocity += getRigidBody()->acceleration;
@@ -3,6 +3,7 @@
 #define __SPACE_SHIP__
 
 #include "Agent.h"
+#include "TextureHandle.h"
 
 class SpaceShip final : public Agent
 {
@@ -39,6 +40,8 @@ private:
 	// where we want to go
 	glm::vec2 m_desiredVelocity;
 
+	TextureHandle m_textureHandle;
+
 	// private functions
 	void m_move();
 };
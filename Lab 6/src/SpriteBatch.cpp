@@ -0,0 +1,176 @@
+#include "SpriteBatch.h"
+
+#include <algorithm>
+#include <cmath>
+#include "Renderer.h"
+
+SpriteBatch::SpriteBatch()
+	: m_isBatching(false), m_layer(0), m_submissionCount(0)
+{
+}
+
+SpriteBatch::~SpriteBatch()
+= default;
+
+void SpriteBatch::begin()
+{
+	m_quads.clear();
+	m_isBatching = true;
+	m_layer = 0;
+	m_submissionCount = 0;
+}
+
+void SpriteBatch::end()
+{
+	flush();
+	m_isBatching = false;
+}
+
+bool SpriteBatch::isBatching() const
+{
+	return m_isBatching;
+}
+
+void SpriteBatch::setLayer(const uint32_t layer_index)
+{
+	m_layer = layer_index;
+}
+
+void SpriteBatch::add(SDL_Texture* texture, const SDL_Rect& src_rect, const SDL_FRect& dest_rect,
+	const double angle, const SDL_Colour colour, const SDL_RendererFlip flip)
+{
+	if (texture == nullptr) return;
+
+	const Quad quad{ texture, m_layer, src_rect, dest_rect, angle, colour, flip };
+
+	if (!m_isBatching)
+	{
+		m_submit(&quad, 1);
+		return;
+	}
+	m_quads.push_back(quad);
+}
+
+void SpriteBatch::flush()
+{
+	if (m_quads.empty()) return;
+
+	// stable, so sprites that share a layer and a texture keep the order they were drawn in
+	std::stable_sort(m_quads.begin(), m_quads.end(), [](const Quad& lhs, const Quad& rhs)
+	{
+		return (lhs.layer != rhs.layer) ? lhs.layer < rhs.layer : lhs.texture < rhs.texture;
+	});
+
+	size_t run_start = 0;
+	for (size_t i = 1; i <= m_quads.size(); ++i)
+	{
+		if (i == m_quads.size() || m_quads[i].texture != m_quads[run_start].texture)
+		{
+			m_submit(&m_quads[run_start], i - run_start);
+			run_start = i;
+		}
+	}
+	m_quads.clear();
+}
+
+int SpriteBatch::getSubmissionCount() const
+{
+	return m_submissionCount;
+}
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+void SpriteBatch::m_submit(const Quad* quads, const size_t count)
+{
+	const auto texture = quads[0].texture;
+	int texture_width, texture_height;
+	SDL_QueryTexture(texture, nullptr, nullptr, &texture_width, &texture_height);
+
+	static std::vector<SDL_Vertex> vertices;
+	static std::vector<int> indices;
+	vertices.clear();
+	indices.clear();
+	vertices.reserve(count * 4);
+	indices.reserve(count * 6);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		const auto& quad = quads[i];
+
+		auto u0 = static_cast<float>(quad.src.x) / texture_width;
+		auto v0 = static_cast<float>(quad.src.y) / texture_height;
+		auto u1 = static_cast<float>(quad.src.x + quad.src.w) / texture_width;
+		auto v1 = static_cast<float>(quad.src.y + quad.src.h) / texture_height;
+		if (quad.flip & SDL_FLIP_HORIZONTAL) std::swap(u0, u1);
+		if (quad.flip & SDL_FLIP_VERTICAL) std::swap(v0, v1);
+
+		// corners about the centre, clockwise from the top left
+		const auto radians = static_cast<float>(quad.angle) * static_cast<float>(M_PI) / 180.0f;
+		const auto cos_angle = std::cos(radians);
+		const auto sin_angle = std::sin(radians);
+		const auto half_width = quad.dest.w * 0.5f;
+		const auto half_height = quad.dest.h * 0.5f;
+		const auto centre_x = quad.dest.x + half_width;
+		const auto centre_y = quad.dest.y + half_height;
+
+		const float corners[4][4] = {
+			{ -half_width, -half_height, u0, v0 },
+			{ half_width, -half_height, u1, v0 },
+			{ half_width, half_height, u1, v1 },
+			{ -half_width, half_height, u0, v1 }
+		};
+
+		const auto first_vertex = static_cast<int>(vertices.size());
+		for (const auto& corner : corners)
+		{
+			SDL_Vertex vertex;
+			vertex.position.x = centre_x + corner[0] * cos_angle - corner[1] * sin_angle;
+			vertex.position.y = centre_y + corner[0] * sin_angle + corner[1] * cos_angle;
+			vertex.color = quad.colour;
+			vertex.tex_coord.x = corner[2];
+			vertex.tex_coord.y = corner[3];
+			vertices.push_back(vertex);
+		}
+
+		for (const auto index : { 0, 1, 2, 0, 2, 3 })
+		{
+			indices.push_back(first_vertex + index);
+		}
+	}
+
+	SDL_RenderGeometry(Renderer::Instance().getRenderer(), texture,
+		vertices.data(), static_cast<int>(vertices.size()), indices.data(), static_cast<int>(indices.size()));
+	++m_submissionCount;
+}
+
+#else
+
+void SpriteBatch::m_submit(const Quad* quads, const size_t count)
+{
+	// no geometry API - the sorted order still saves the texture switches between copies
+	// and the colour and alpha mod are only changed when they differ from the previous quad
+	const auto renderer = Renderer::Instance().getRenderer();
+	const auto texture = quads[0].texture;
+
+	SDL_Colour colour;
+	SDL_GetTextureColorMod(texture, &colour.r, &colour.g, &colour.b);
+	SDL_GetTextureAlphaMod(texture, &colour.a);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		const auto& quad = quads[i];
+		if (quad.colour.r != colour.r || quad.colour.g != colour.g || quad.colour.b != colour.b)
+		{
+			SDL_SetTextureColorMod(texture, quad.colour.r, quad.colour.g, quad.colour.b);
+		}
+		if (quad.colour.a != colour.a)
+		{
+			SDL_SetTextureAlphaMod(texture, quad.colour.a);
+		}
+		colour = quad.colour;
+		SDL_RenderCopyExF(renderer, texture, &quad.src, &quad.dest, quad.angle, nullptr, quad.flip);
+		++m_submissionCount;
+	}
+}
+
+#endif
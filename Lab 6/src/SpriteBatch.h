@@ -0,0 +1,66 @@
+#pragma once
+#ifndef __SPRITE_BATCH__
+#define __SPRITE_BATCH__
+
+#include <vector>
+#include <SDL.h>
+
+/* Singleton */
+/*
+ * Collects textured quads during a draw pass and submits them grouped by layer, then by texture.
+ * With SDL 2.0.18 or newer every run of quads that share a texture goes out in one SDL_RenderGeometry
+ * call. Older SDL versions fall back to one SDL_RenderCopyExF per quad in the same sorted order.
+ * Anything that draws to the renderer directly must call flush() first so the pending sprites stay underneath.
+ */
+class SpriteBatch
+{
+public:
+	static SpriteBatch& Instance()
+	{
+		static SpriteBatch instance;
+		return instance;
+	}
+
+	// quads are only collected between begin and end - outside of a pass add draws straight away
+	void begin();
+	void end();
+	bool isBatching() const;
+
+	// layer the following quads are sorted under
+	void setLayer(uint32_t layer_index);
+
+	// dest_rect is in screen space - angle is in degrees about the centre of dest_rect
+	// colour replaces the texture's colour and alpha mod, so textures shared through an atlas can be tinted separately
+	void add(SDL_Texture* texture, const SDL_Rect& src_rect, const SDL_FRect& dest_rect,
+		double angle = 0.0, SDL_Colour colour = { 255, 255, 255, 255 }, SDL_RendererFlip flip = SDL_FLIP_NONE);
+
+	// submits everything collected so far
+	void flush();
+
+	// number of render calls the last flushes made this pass - reset by begin
+	int getSubmissionCount() const;
+
+private:
+	SpriteBatch();
+	~SpriteBatch();
+
+	struct Quad
+	{
+		SDL_Texture* texture;
+		uint32_t layer;
+		SDL_Rect src;
+		SDL_FRect dest;
+		double angle;
+		SDL_Colour colour;
+		SDL_RendererFlip flip;
+	};
+
+	void m_submit(const Quad* quads, size_t count);
+
+	std::vector<Quad> m_quads;
+	bool m_isBatching;
+	uint32_t m_layer;
+	int m_submissionCount;
+};
+
+#endif /* defined (__SPRITE_BATCH__) */
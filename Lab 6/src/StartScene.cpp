@@ -45,22 +45,24 @@ void StartScene::handleEvents()
 
 void StartScene::start()
 {
+	TextureManager::Instance().beginAtlas("start_scene");
+
 	const SDL_Color blue = { 0, 0, 255, 255 };
-	m_pStartLabel = new Label("START SCENE", "Consolas", 80, blue, glm::vec2(400.0f, 40.0f));
+	m_pStartLabel = create<Label>("START SCENE", "Consolas", 80, blue, glm::vec2(400.0f, 40.0f));
 	m_pStartLabel->setParent(this);
 	addChild(m_pStartLabel);
 
-	m_pInstructionsLabel = new Label("Press 1 to Play", "Consolas", 40, blue, glm::vec2(400.0f, 120.0f));
+	m_pInstructionsLabel = create<Label>("Press 1 to Play", "Consolas", 40, blue, glm::vec2(400.0f, 120.0f));
 	m_pInstructionsLabel->setParent(this);
 	addChild(m_pInstructionsLabel);
 
 
-	m_pShip = new Ship();
+	m_pShip = create<Ship>();
 	m_pShip->getTransform()->position = glm::vec2(400.0f, 300.0f); 
 	addChild(m_pShip); 
 
 	// Start Button
-	m_pStartButton = new Button();
+	m_pStartButton = create<Button>();
 	m_pStartButton->getTransform()->position = glm::vec2(400.0f, 400.0f); 
 
 	m_pStartButton->addEventListener(CLICK, [&]()-> void
@@ -80,6 +82,8 @@ void StartScene::start()
 	});
 	addChild(m_pStartButton);
 
+	TextureManager::Instance().endAtlas();
+
 	ImGuiWindowFrame::Instance().setDefaultGUIFunction();
 }
 
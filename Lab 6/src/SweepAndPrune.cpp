@@ -0,0 +1,101 @@
+#include "SweepAndPrune.h"
+
+#include <algorithm>
+#include "ComponentManager.h"
+
+SweepAndPrune::SweepAndPrune()
+= default;
+
+SweepAndPrune::~SweepAndPrune()
+= default;
+
+void SweepAndPrune::addObject(DisplayObject* object)
+{
+	Entry entry{};
+	entry.object = object;
+	entry.entityId = object->getEntityId();
+	m_computeBounds(entry);
+	m_entries.push_back(entry);
+
+	// the new entry is sorted into place on the next update
+}
+
+void SweepAndPrune::removeObject(DisplayObject* object)
+{
+	// erase keeps the remaining entries in sorted order
+	m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(),
+		[object](const Entry& entry) { return entry.object == object; }), m_entries.end());
+}
+
+void SweepAndPrune::clear()
+{
+	m_entries.clear();
+	m_candidatePairs.clear();
+}
+
+void SweepAndPrune::update()
+{
+	ComponentManager::Instance().updateBounds();
+	for (auto& entry : m_entries)
+	{
+		m_computeBounds(entry);
+	}
+
+	m_insertionSort();
+
+	// sweep along x - only entries whose x intervals overlap are tested on y
+	m_candidatePairs.clear();
+	const auto count = m_entries.size();
+	for (size_t i = 0; i < count; ++i)
+	{
+		const auto& current = m_entries[i];
+		for (size_t j = i + 1; j < count; ++j)
+		{
+			const auto& other = m_entries[j];
+			if (other.minX > current.maxX)
+			{
+				break; // every entry after this one starts even further right
+			}
+
+			if (current.minY < other.maxY && current.maxY > other.minY)
+			{
+				m_candidatePairs.emplace_back(current.object, other.object);
+			}
+		}
+	}
+}
+
+const std::vector<SweepAndPrune::CandidatePair>& SweepAndPrune::getCandidatePairs() const
+{
+	return m_candidatePairs;
+}
+
+int SweepAndPrune::numberOfObjects() const
+{
+	return static_cast<int>(m_entries.size());
+}
+
+void SweepAndPrune::m_computeBounds(Entry& entry)
+{
+	const auto bounds = (entry.entityId == -1) ? entry.object->getBounds() : ComponentManager::Instance().getBounds(entry.entityId);
+	entry.minX = bounds.lowerBound.x;
+	entry.maxX = bounds.upperBound.x;
+	entry.minY = bounds.lowerBound.y;
+	entry.maxY = bounds.upperBound.y;
+}
+
+void SweepAndPrune::m_insertionSort()
+{
+	// nearly sorted from the previous frame, so each entry only shifts a few places
+	for (size_t i = 1; i < m_entries.size(); ++i)
+	{
+		const auto entry = m_entries[i];
+		auto j = i;
+		while (j > 0 && m_entries[j - 1].minX > entry.minX)
+		{
+			m_entries[j] = m_entries[j - 1];
+			--j;
+		}
+		m_entries[j] = entry;
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+#ifndef __SWEEP_AND_PRUNE__
+#define __SWEEP_AND_PRUNE__
+
+#include <utility>
+#include <vector>
+#include "DisplayObject.h"
+
+/*
+ * Broadphase that keeps every registered object sorted along the x axis.
+ * Objects move a little each frame, so the order is repaired with an insertion sort
+ * (close to linear) instead of being rebuilt. Pairs whose bounds overlap on both axes
+ * are handed to the narrow phase functions in CollisionManager.
+ * Objects in the ComponentManager take their bounds from its dense pass, the rest are asked one by one.
+ */
+class SweepAndPrune
+{
+public:
+	typedef std::pair<DisplayObject*, DisplayObject*> CandidatePair;
+
+	SweepAndPrune();
+	~SweepAndPrune();
+
+	void addObject(DisplayObject* object);
+	void removeObject(DisplayObject* object);
+	void clear();
+
+	// refreshes bounds, repairs the sort order and rebuilds the candidate pair list
+	void update();
+
+	const std::vector<CandidatePair>& getCandidatePairs() const;
+	int numberOfObjects() const;
+
+private:
+	struct Entry
+	{
+		float minX;
+		float maxX;
+		float minY;
+		float maxY;
+		DisplayObject* object;
+		int entityId; // ComponentManager entity, -1 if the object does not use it
+	};
+
+	std::vector<Entry> m_entries;
+	std::vector<CandidatePair> m_candidatePairs;
+
+	static void m_computeBounds(Entry& entry);
+	void m_insertionSort();
+};
+
+#endif /* defined (__SWEEP_AND_PRUNE__) */
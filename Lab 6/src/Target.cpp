@@ -6,9 +6,12 @@
 
 Target::Target()
 {
-	TextureManager::Instance().load("../Assets/textures/Circle.png","circle");
+	// the target is dragged around and tracked by the agents, so it lives with the other movers
+	useComponentManager();
 
-	const auto size = TextureManager::Instance().getTextureSize("circle");
+	m_textureHandle = TextureManager::Instance().load("../Assets/textures/Circle.png","circle");
+
+	const auto size = TextureManager::Instance().getTextureSize(m_textureHandle);
 	setWidth(size.x);
 	setHeight(size.y);
 	getTransform()->position = glm::vec2(500.0f, 100.0f);
@@ -28,7 +31,7 @@ void Target::draw()
 	const auto y = getTransform()->position.y;
 
 	// draw the target
-	TextureManager::Instance().draw("circle", x, y, 0, 255, isCentered());
+	TextureManager::Instance().draw(m_textureHandle, x, y, 0, 255, isCentered());
 }
 
 void Target::update()
@@ -3,6 +3,7 @@
 #define __TARGET__
 
 #include "NavigationObject.h"
+#include "TextureHandle.h"
 
 class Target final : public NavigationObject
 {
@@ -19,6 +20,8 @@ private:
 	void m_move();
 	void m_checkBounds();
 	void m_reset();
+
+	TextureHandle m_textureHandle;
 };
 
 
@@ -0,0 +1,10 @@
+#pragma once
+#ifndef __TEXTURE_HANDLE__
+#define __TEXTURE_HANDLE__
+
+// index into TextureManager's dense texture array - stays valid until that texture is removed
+typedef int TextureHandle;
+
+const TextureHandle INVALID_TEXTURE_HANDLE = -1;
+
+#endif /* defined (__TEXTURE_HANDLE__) */
@@ -1,4 +1,8 @@
 #include "TextureManager.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
 #include <SDL_image.h>
 #include "Game.h"
 #include <utility>
@@ -6,10 +10,15 @@
 #include <sstream>
 #include "Frame.h"
 #include <iterator>
+#include "RectanglePacker.h"
 #include "Renderer.h"
+#include "SpriteBatch.h"
 
 TextureManager::TextureManager()
-= default;
+	: m_textTextureBytes(0), m_textTextureBudget(Config::TEXT_TEXTURE_BUDGET),
+	m_isPackingAtlas(false), m_numberOfCachedAtlasPages(0)
+{
+}
 
 TextureManager::~TextureManager()
 = default;
@@ -19,16 +28,72 @@ inline bool TextureManager::m_textureExists(const std::string & id)
 	return m_textureMap.find(id) != m_textureMap.end();
 }
 
+TextureHandle TextureManager::m_addRecord(std::shared_ptr<SDL_Texture> texture)
+{
+	TextureRecord record{ std::move(texture), 0, 0, { 0, 0, 0, 0 }, { 255, 255, 255, 255 } };
+	SDL_QueryTexture(record.texture.get(), nullptr, nullptr, &record.width, &record.height);
+	record.source = { 0, 0, record.width, record.height };
+
+	return m_storeRecord(record);
+}
+
+TextureHandle TextureManager::m_storeRecord(const TextureRecord& record)
+{
+	if (!m_freeHandles.empty())
+	{
+		const auto handle = m_freeHandles.back();
+		m_freeHandles.pop_back();
+		m_textures[handle] = record;
+		return handle;
+	}
+
+	m_textures.push_back(record);
+	return static_cast<TextureHandle>(m_textures.size()) - 1;
+}
+
+const TextureManager::TextureRecord* TextureManager::m_getRecord(const TextureHandle handle) const
+{
+	if (handle < 0 || handle >= static_cast<TextureHandle>(m_textures.size()) || m_textures[handle].texture == nullptr)
+	{
+		return nullptr;
+	}
+	return &m_textures[handle];
+}
+
 bool TextureManager::m_spriteSheetExists(const std::string & sprite_sheet_name)
 {
 	return m_spriteSheetMap.find(sprite_sheet_name) != m_spriteSheetMap.end();
 }
 
-bool TextureManager::load(const std::string & file_name, const std::string & id)
+SDL_FRect TextureManager::m_toScreen(const SDL_Rect& dest_rect)
+{
+	// rotation is about the rect's centre, which a move plus a uniform scale preserves
+	const auto& renderer = Renderer::Instance();
+	const auto top_left = renderer.worldToScreen(glm::vec2(dest_rect.x, dest_rect.y));
+	const auto zoom = renderer.getZoom();
+	return { top_left.x, top_left.y, dest_rect.w * zoom, dest_rect.h * zoom };
+}
+
+void TextureManager::m_submit(const TextureRecord& record, SDL_Rect src_rect, const SDL_Rect& dest_rect, const double angle, const int alpha, const SDL_RendererFlip flip)
+{
+	// src_rect is relative to the texture's own image, wherever that ended up in an atlas
+	src_rect.x += record.source.x;
+	src_rect.y += record.source.y;
+
+	const SDL_Colour colour = { record.colour.r, record.colour.g, record.colour.b, static_cast<Uint8>(alpha) };
+	SpriteBatch::Instance().add(record.texture.get(), src_rect, m_toScreen(dest_rect), angle, colour, flip);
+}
+
+TextureHandle TextureManager::load(const std::string & file_name, const std::string & id)
 {
 	if (m_textureExists(id))
 	{
-		return true;
+		return m_textureMap[id];
+	}
+
+	if (m_isPackingAtlas)
+	{
+		return m_addAtlasEntry(file_name, id);
 	}
 
 	const auto pTempSurface(Config::make_resource(IMG_Load(file_name.c_str())));
@@ -36,7 +101,7 @@ bool TextureManager::load(const std::string & file_name, const std::string & id)
 
 	if (pTempSurface == nullptr)
 	{
-		return false;
+		return INVALID_TEXTURE_HANDLE;
 	}
 
 	const auto pTexture(Config::make_resource(SDL_CreateTextureFromSurface(Renderer::Instance().getRenderer(), pTempSurface.get())));
@@ -44,11 +109,12 @@ bool TextureManager::load(const std::string & file_name, const std::string & id)
 	// everything went ok, add the texture to our list
 	if (pTexture != nullptr)
 	{
-		m_textureMap[id] = pTexture;
-		return true;
+		const auto handle = m_addRecord(pTexture);
+		m_textureMap[id] = handle;
+		return handle;
 	}
 
-	return false;
+	return INVALID_TEXTURE_HANDLE;
 }
 
 bool TextureManager::loadSpriteSheet(
@@ -116,24 +182,280 @@ bool TextureManager::loadSpriteSheet(
 	return true;
 }
 
+void TextureManager::beginAtlas(const std::string & atlas_name)
+{
+	m_isPackingAtlas = true;
+	m_atlasName = atlas_name;
+	m_atlasEntries.clear();
+	m_readAtlasCache();
+}
+
+void TextureManager::endAtlas()
+{
+	m_isPackingAtlas = false;
+	if (m_atlasEntries.empty()) return;
+
+	// the cached pages only fit if every texture was found there and nothing else is in them
+	std::vector<std::shared_ptr<SDL_Texture>> pages;
+	auto from_cache = m_atlasCache.size() == m_atlasEntries.size() &&
+		std::all_of(m_atlasEntries.begin(), m_atlasEntries.end(), [](const AtlasEntry& entry) { return entry.surface == nullptr; });
+	if (from_cache)
+	{
+		from_cache = m_loadCachedAtlas(pages);
+	}
+	if (!from_cache)
+	{
+		m_packAtlas(pages);
+	}
+
+	for (auto& entry : m_atlasEntries)
+	{
+		// skip anything removed again before the atlas was finished
+		if (getHandle(entry.id) != entry.handle) continue;
+
+		auto& record = m_textures[entry.handle];
+		if (entry.page >= 0)
+		{
+			record.texture = pages[entry.page];
+			record.source = entry.rect;
+		}
+		else if (entry.surface != nullptr)
+		{
+			record.texture = Config::make_resource(SDL_CreateTextureFromSurface(Renderer::Instance().getRenderer(), entry.surface.get()));
+			record.source = { 0, 0, record.width, record.height };
+		}
+	}
+
+	std::cout << "Atlas " << m_atlasName << ": " << m_atlasEntries.size() << " textures on " << pages.size()
+		<< " page(s)" << (from_cache ? " (cached)" : "") << std::endl;
+
+	m_atlasEntries.clear();
+	m_atlasCache.clear();
+}
+
+TextureHandle TextureManager::m_addAtlasEntry(const std::string & file_name, const std::string & id)
+{
+	AtlasEntry entry{ id, INVALID_TEXTURE_HANDLE, file_name, m_getFileStamp(file_name), nullptr, -1, { 0, 0, 0, 0 } };
+
+	// an unchanged file already has a place in the cached atlas, so only its size is needed
+	const auto cached = m_atlasCache.find(id);
+	if (cached != m_atlasCache.end() && !entry.fileStamp.empty() &&
+		cached->second.fileName == file_name && cached->second.fileStamp == entry.fileStamp)
+	{
+		entry.page = cached->second.page;
+		entry.rect = cached->second.rect;
+	}
+	else
+	{
+		entry.surface = Config::make_resource(IMG_Load(file_name.c_str()));
+		if (entry.surface == nullptr)
+		{
+			return INVALID_TEXTURE_HANDLE;
+		}
+		entry.rect = { 0, 0, entry.surface->w, entry.surface->h };
+	}
+
+	const TextureRecord record{ nullptr, entry.rect.w, entry.rect.h, { 0, 0, entry.rect.w, entry.rect.h }, { 255, 255, 255, 255 } };
+	entry.handle = m_storeRecord(record);
+	m_textureMap[id] = entry.handle;
+	m_atlasEntries.push_back(entry);
+
+	return entry.handle;
+}
+
+bool TextureManager::m_loadCachedAtlas(std::vector<std::shared_ptr<SDL_Texture>>& pages)
+{
+	const auto renderer = Renderer::Instance().getRenderer();
+	for (auto page = 0; page < m_numberOfCachedAtlasPages; ++page)
+	{
+		const auto pTexture(Config::make_resource(IMG_LoadTexture(renderer, m_getAtlasCachePath(page).c_str())));
+		if (pTexture == nullptr)
+		{
+			pages.clear();
+			return false;
+		}
+		SDL_SetTextureBlendMode(pTexture.get(), SDL_BLENDMODE_BLEND);
+		pages.push_back(pTexture);
+	}
+
+	// textures too big for a page are loaded on their own
+	for (auto& entry : m_atlasEntries)
+	{
+		if (entry.page < 0)
+		{
+			entry.surface = Config::make_resource(IMG_Load(entry.fileName.c_str()));
+		}
+	}
+	return true;
+}
+
+void TextureManager::m_packAtlas(std::vector<std::shared_ptr<SDL_Texture>>& pages)
+{
+	const auto renderer = Renderer::Instance().getRenderer();
+
+	// entries placed from a cache that can't be used after all still need their pixels
+	for (auto& entry : m_atlasEntries)
+	{
+		if (entry.surface == nullptr)
+		{
+			entry.surface = Config::make_resource(IMG_Load(entry.fileName.c_str()));
+		}
+
+		// a file that is gone now is left out of the pages, so its cached place must not be used either
+		if (entry.surface == nullptr)
+		{
+			entry.page = -1;
+		}
+	}
+
+	SDL_RendererInfo info;
+	auto page_width = Config::ATLAS_PAGE_SIZE;
+	auto page_height = Config::ATLAS_PAGE_SIZE;
+	if (SDL_GetRendererInfo(renderer, &info) == 0 && info.max_texture_width > 0 && info.max_texture_height > 0)
+	{
+		page_width = std::min(page_width, info.max_texture_width);
+		page_height = std::min(page_height, info.max_texture_height);
+	}
+
+	// tallest first keeps the shelves tight
+	std::vector<AtlasEntry*> order;
+	for (auto& entry : m_atlasEntries)
+	{
+		if (entry.surface != nullptr)
+		{
+			order.push_back(&entry);
+		}
+	}
+	std::stable_sort(order.begin(), order.end(), [](const AtlasEntry* lhs, const AtlasEntry* rhs) { return lhs->surface->h > rhs->surface->h; });
+
+	RectanglePacker packer(page_width, page_height);
+	for (auto entry : order)
+	{
+		if (!packer.pack(entry->surface->w, entry->surface->h, entry->page, entry->rect))
+		{
+			entry->page = -1;
+		}
+	}
+
+	std::error_code error;
+	std::filesystem::create_directories(std::filesystem::path(m_getAtlasCachePath()).parent_path(), error);
+
+	for (auto page = 0; page < packer.numberOfPages(); ++page)
+	{
+		const auto size = packer.getUsedSize(page);
+		const auto pSurface(Config::make_resource(SDL_CreateRGBSurfaceWithFormat(0, size.x, size.y, 32, SDL_PIXELFORMAT_RGBA32)));
+		if (pSurface == nullptr)
+		{
+			pages.push_back(nullptr);
+			continue;
+		}
+
+		// copy the pixels as they are - blending onto the transparent page would darken the edges
+		for (auto entry : order)
+		{
+			if (entry->page != page) continue;
+			SDL_SetSurfaceBlendMode(entry->surface.get(), SDL_BLENDMODE_NONE);
+			SDL_BlitSurface(entry->surface.get(), nullptr, pSurface.get(), &entry->rect);
+		}
+
+		IMG_SavePNG(pSurface.get(), m_getAtlasCachePath(page).c_str());
+
+		const auto pTexture(Config::make_resource(SDL_CreateTextureFromSurface(renderer, pSurface.get())));
+		SDL_SetTextureBlendMode(pTexture.get(), SDL_BLENDMODE_BLEND);
+		pages.push_back(pTexture);
+	}
+
+	m_writeAtlasCache(packer.numberOfPages());
+}
+
+void TextureManager::m_readAtlasCache()
+{
+	m_atlasCache.clear();
+	m_numberOfCachedAtlasPages = 0;
+
+	std::ifstream cacheFile(m_getAtlasCachePath());
+	if (!cacheFile)
+	{
+		return;
+	}
+
+	// first line is the page count, then one "id page x y w h stamp file_name" line per texture
+	// page is -1 for a texture that was too big for a page
+	std::string label;
+	cacheFile >> label >> m_numberOfCachedAtlasPages;
+
+	AtlasEntry entry{};
+	while (cacheFile >> entry.id >> entry.page >> entry.rect.x >> entry.rect.y >> entry.rect.w >> entry.rect.h >> entry.fileStamp)
+	{
+		std::getline(cacheFile >> std::ws, entry.fileName);
+		m_atlasCache[entry.id] = entry;
+	}
+}
+
+void TextureManager::m_writeAtlasCache(const int number_of_pages) const
+{
+	std::ofstream cacheFile(m_getAtlasCachePath());
+	if (!cacheFile)
+	{
+		return;
+	}
+
+	cacheFile << "pages " << number_of_pages << "\n";
+	for (const auto& entry : m_atlasEntries)
+	{
+		if (entry.fileStamp.empty()) continue;
+
+		cacheFile << entry.id << " " << entry.page << " "
+			<< entry.rect.x << " " << entry.rect.y << " " << entry.rect.w << " " << entry.rect.h << " "
+			<< entry.fileStamp << " " << entry.fileName << "\n";
+	}
+}
+
+std::string TextureManager::m_getAtlasCachePath(const int page) const
+{
+	const std::string base = "../Assets/cache/" + m_atlasName;
+	return (page < 0) ? base + ".atlas" : base + "_" + std::to_string(page) + ".png";
+}
+
+std::string TextureManager::m_getFileStamp(const std::string & file_name)
+{
+	// size and modification time - an empty stamp means the file can't be cached
+	std::error_code error;
+	const auto size = std::filesystem::file_size(file_name, error);
+	if (error) return "";
+
+	const auto time = std::filesystem::last_write_time(file_name, error);
+	if (error) return "";
+
+	return std::to_string(size) + ":" + std::to_string(time.time_since_epoch().count());
+}
+
 void TextureManager::draw(const std::string & id, const int x, const int y, const double angle, const int alpha, const bool centered, const SDL_RendererFlip flip)
 {
+	draw(getHandle(id), x, y, angle, alpha, centered, flip);
+}
+
+void TextureManager::draw(const std::string& id, const int x, const int y, GameObject* g, const double angle, const int alpha, const bool centered, const SDL_RendererFlip flip)
+{
+	draw(getHandle(id), x, y, g, angle, alpha, centered, flip);
+}
+
+void TextureManager::draw(const TextureHandle handle, const int x, const int y, const double angle, const int alpha, const bool centered, const SDL_RendererFlip flip)
+{
+	const auto record = m_getRecord(handle);
+	if (record == nullptr) return;
+
 	SDL_Rect srcRect;
 	SDL_Rect destRect;
 
 	srcRect.x = 0;
 	srcRect.y = 0;
-
-	int textureWidth, textureHeight;
-
-	SDL_QueryTexture(m_textureMap[id].get(), nullptr, nullptr, &textureWidth, &textureHeight);
-
-	srcRect.w = destRect.w = textureWidth;
-	srcRect.h = destRect.h = textureHeight;
+	srcRect.w = destRect.w = record->width;
+	srcRect.h = destRect.h = record->height;
 
 	if (centered) {
-		const int xOffset = textureWidth * 0.5;
-		const int yOffset = textureHeight * 0.5;
+		const int xOffset = record->width * 0.5;
+		const int yOffset = record->height * 0.5;
 		destRect.x = x - xOffset;
 		destRect.y = y - yOffset;
 	}
@@ -142,20 +464,18 @@ void TextureManager::draw(const std::string & id, const int x, const int y, cons
 		destRect.y = y;
 	}
 
-	SDL_SetTextureAlphaMod(m_textureMap[id].get(), alpha);
-	SDL_RenderCopyEx(Renderer::Instance().getRenderer(), m_textureMap[id].get(), &srcRect, &destRect, angle, nullptr, flip);
+	m_submit(*record, srcRect, destRect, angle, alpha, flip);
 }
 
-void TextureManager::draw(const std::string& id, int x, int y, GameObject* g, double angle, int alpha, bool centered, SDL_RendererFlip flip)
+void TextureManager::draw(const TextureHandle handle, const int x, const int y, GameObject* g, const double angle, const int alpha, const bool centered, const SDL_RendererFlip flip)
 {
+	const auto record = m_getRecord(handle);
+	if (record == nullptr) return;
+
 	SDL_Rect srcRect;
 	SDL_Rect destRect;
 
-	int textureWidth, textureHeight;
-
-	SDL_QueryTexture(m_textureMap[id].get(), nullptr, nullptr, &textureWidth, &textureHeight);
-
-	srcRect = { 0, 0, textureWidth, textureHeight };
+	srcRect = { 0, 0, record->width, record->height };
 
 	destRect.w = g->getWidth();
 	destRect.h = g->getHeight();
@@ -171,8 +491,7 @@ void TextureManager::draw(const std::string& id, int x, int y, GameObject* g, do
 		destRect.y = y;
 	}
 
-	SDL_SetTextureAlphaMod(m_textureMap[id].get(), alpha);
-	SDL_RenderCopyEx(Renderer::Instance().getRenderer(), m_textureMap[id].get(), &srcRect, &destRect, angle, nullptr, flip);
+	m_submit(*record, srcRect, destRect, angle, alpha, flip);
 }
 
 void TextureManager::drawFrame(const std::string & id, const int x, const int y, const int frame_width,
@@ -183,6 +502,9 @@ void TextureManager::drawFrame(const std::string & id, const int x, const int y,
 {
 	animateFrames(frame_width, frame_height, frame_number, row_number, speed_factor, current_frame, current_row);
 
+	const auto record = m_getRecord(getHandle(id));
+	if (record == nullptr) return;
+
 	SDL_Rect srcRect;
 	SDL_Rect destRect;
 
@@ -214,8 +536,7 @@ void TextureManager::drawFrame(const std::string & id, const int x, const int y,
 		destRect.y = y;
 	}
 
-	SDL_SetTextureAlphaMod(m_textureMap[id].get(), alpha);
-	SDL_RenderCopyEx(Renderer::Instance().getRenderer(), m_textureMap[id].get(), &srcRect, &destRect, angle, nullptr, flip);
+	m_submit(*record, srcRect, destRect, angle, alpha, flip);
 }
 
 void TextureManager::animateFrames(int frame_width, int frame_height, const int frame_number, const int row_number, const float speed_factor, int& current_frame, int& current_row)
@@ -263,6 +584,9 @@ void TextureManager::playAnimation(
 		}
 	}
 
+	const auto record = m_getRecord(getHandle(sprite_sheet_name));
+	if (record == nullptr) return;
+
 	SDL_Rect srcRect;
 	SDL_Rect destRect;
 
@@ -294,64 +618,56 @@ void TextureManager::playAnimation(
 		destRect.y = y;
 	}
 
-	SDL_SetTextureAlphaMod(m_textureMap[sprite_sheet_name].get(), alpha);
-	SDL_RenderCopyEx(Renderer::Instance().getRenderer(), m_textureMap[sprite_sheet_name].get(), &srcRect, &destRect, angle, nullptr, flip);
+	m_submit(*record, srcRect, destRect, angle, alpha, flip);
 }
 
 void TextureManager::drawText(const std::string & id, const int x, const int y, const double angle, const int alpha, const bool centered, const SDL_RendererFlip flip)
 {
-	SDL_Rect srcRect;
-	SDL_Rect destRect;
+	m_touchTextTexture(id);
 
-	srcRect.x = 0;
-	srcRect.y = 0;
-
-	int textureWidth, textureHeight;
-
-	SDL_QueryTexture(m_textureMap[id].get(), nullptr, nullptr, &textureWidth, &textureHeight);
-
-	srcRect.w = destRect.w = textureWidth;
-	srcRect.h = destRect.h = textureHeight;
+	// text textures are drawn at their natural size, the same way as any other texture
+	draw(getHandle(id), x, y, angle, alpha, centered, flip);
+}
 
-	if (centered) {
-		const int xOffset = textureWidth * 0.5;
-		const int yOffset = textureHeight * 0.5;
-		destRect.x = x - xOffset;
-		destRect.y = y - yOffset;
-	}
-	else {
-		destRect.x = x;
-		destRect.y = y;
-	}
+void TextureManager::drawRegion(const TextureHandle handle, const SDL_Rect& src_rect, const SDL_Rect& dest_rect, const double angle, const int alpha, const SDL_RendererFlip flip)
+{
+	const auto record = m_getRecord(handle);
+	if (record == nullptr) return;
 
-	SDL_SetTextureAlphaMod(m_textureMap[id].get(), alpha);
-	SDL_RenderCopyEx(Renderer::Instance().getRenderer(), m_textureMap[id].get(), &srcRect, &destRect, angle, nullptr, flip);
+	m_submit(*record, src_rect, dest_rect, angle, alpha, flip);
 }
 
 glm::vec2 TextureManager::getTextureSize(const std::string & id)
 {
-	int width, height;
-	SDL_QueryTexture(m_textureMap[id].get(), nullptr, nullptr, &width, &height);
-	glm::vec2 size;
+	return getTextureSize(getHandle(id));
+}
 
-	size.x = width;
-	size.y = height;
+glm::vec2 TextureManager::getTextureSize(const TextureHandle handle) const
+{
+	// sizes are known before an atlas is built, so this does not need the texture itself
+	if (handle < 0 || handle >= static_cast<TextureHandle>(m_textures.size()))
+	{
+		return glm::vec2(0.0f, 0.0f);
+	}
 
-	return size;
+	return glm::vec2(m_textures[handle].width, m_textures[handle].height);
 }
 
 void TextureManager::setAlpha(const std::string & id, const Uint8 new_alpha)
 {
-	auto pTexture = m_textureMap[id];
-	SDL_SetTextureAlphaMod(pTexture.get(), new_alpha);
-	pTexture = nullptr;
+	const auto record = m_getRecord(getHandle(id));
+	if (record == nullptr) return;
+
+	SDL_SetTextureAlphaMod(record->texture.get(), new_alpha);
 }
 
 void TextureManager::setColour(const std::string & id, const Uint8 red, const Uint8 green, const Uint8 blue)
 {
-	auto pTexture = m_textureMap[id];
-	SDL_SetTextureColorMod(pTexture.get(), red, green, blue);
-	pTexture = nullptr;
+	const auto handle = getHandle(id);
+	if (handle == INVALID_TEXTURE_HANDLE) return;
+
+	// kept on the record because the texture may be an atlas shared with other ids
+	m_textures[handle].colour = { red, green, blue, 255 };
 }
 
 bool TextureManager::addTexture(const std::string & id, std::shared_ptr<SDL_Texture> texture)
@@ -361,19 +677,126 @@ bool TextureManager::addTexture(const std::string & id, std::shared_ptr<SDL_Text
 		return true;
 	}
 
-	m_textureMap[id] = std::move(texture);
+	if (texture == nullptr)
+	{
+		return false;
+	}
+
+	m_textureMap[id] = m_addRecord(std::move(texture));
+
+	return true;
+}
+
+bool TextureManager::addTextTexture(const std::string & id, std::shared_ptr<SDL_Texture> texture)
+{
+	if (m_textureExists(id))
+	{
+		m_touchTextTexture(id);
+		return true;
+	}
+
+	Uint32 format;
+	int width, height;
+	if (texture == nullptr || SDL_QueryTexture(texture.get(), &format, nullptr, &width, &height) != 0)
+	{
+		return false;
+	}
+
+	addTexture(id, std::move(texture));
 
+	m_recentTextTextures.push_front(id);
+	const auto bytes = static_cast<size_t>(width) * height * SDL_BYTESPERPIXEL(format);
+	m_textTextures[id] = { 0, bytes, m_recentTextTextures.begin() };
+	m_textTextureBytes += bytes;
+
+	m_evictTextTextures(id);
 	return true;
 }
 
+void TextureManager::acquireTextTexture(const std::string & id)
+{
+	const auto entry = m_textTextures.find(id);
+	if (entry != m_textTextures.end())
+	{
+		++entry->second.references;
+	}
+}
+
+void TextureManager::releaseTextTexture(const std::string & id)
+{
+	const auto entry = m_textTextures.find(id);
+	if (entry != m_textTextures.end() && entry->second.references > 0)
+	{
+		--entry->second.references;
+	}
+	m_evictTextTextures("");
+}
+
+void TextureManager::setTextTextureBudget(const size_t bytes)
+{
+	m_textTextureBudget = bytes;
+	m_evictTextTextures("");
+}
+
+void TextureManager::m_touchTextTexture(const std::string & id)
+{
+	const auto entry = m_textTextures.find(id);
+	if (entry != m_textTextures.end())
+	{
+		m_recentTextTextures.splice(m_recentTextTextures.begin(), m_recentTextTextures, entry->second.recentPosition);
+	}
+}
+
+void TextureManager::m_evictTextTextures(const std::string & keep_id)
+{
+	// oldest first - textures a label still shows are never removed, so the budget can be exceeded by those
+	auto it = m_recentTextTextures.end();
+	while (m_textTextureBytes > m_textTextureBudget && it != m_recentTextTextures.begin())
+	{
+		--it;
+		const auto& entry = m_textTextures[*it];
+		if (entry.references > 0 || *it == keep_id) continue;
+
+		const auto id = *it;
+		it = std::next(it);
+		removeTexture(id); // also drops the entry and its place in the list
+	}
+}
+
+TextureHandle TextureManager::getHandle(const std::string & id) const
+{
+	// find rather than operator[] so a mistyped id does not add an empty entry
+	const auto it = m_textureMap.find(id);
+	return (it != m_textureMap.end()) ? it->second : INVALID_TEXTURE_HANDLE;
+}
+
 SDL_Texture* TextureManager::getTexture(const std::string & id)
 {
-	return m_textureMap[id].get();
+	return getTexture(getHandle(id));
+}
+
+SDL_Texture* TextureManager::getTexture(const TextureHandle handle) const
+{
+	const auto record = m_getRecord(handle);
+	return (record != nullptr) ? record->texture.get() : nullptr;
 }
 
 void TextureManager::removeTexture(const std::string & id)
 {
-	m_textureMap.erase(id);
+	const auto it = m_textureMap.find(id);
+	if (it == m_textureMap.end()) return;
+
+	const auto text_texture = m_textTextures.find(id);
+	if (text_texture != m_textTextures.end())
+	{
+		m_textTextureBytes -= text_texture->second.bytes;
+		m_recentTextTextures.erase(text_texture->second.recentPosition);
+		m_textTextures.erase(text_texture);
+	}
+
+	m_textures[it->second] = TextureRecord();
+	m_freeHandles.push_back(it->second);
+	m_textureMap.erase(it);
 }
 
 int TextureManager::getTextureMapSize() const
@@ -384,10 +807,19 @@ int TextureManager::getTextureMapSize() const
 void TextureManager::clean()
 {
 	m_textureMap.clear();
+	m_textures.clear();
+	m_freeHandles.clear();
+	m_textTextures.clear();
+	m_recentTextTextures.clear();
+	m_textTextureBytes = 0;
 	std::cout << "TextureMap Cleared,  TextureMap Size: " << m_textureMap.size() << std::endl;
 
 	m_spriteSheetMap.clear();
 	std::cout << "Existing SpriteSheets Cleared" << std::endl;
+
+	m_isPackingAtlas = false;
+	m_atlasEntries.clear();
+	m_atlasCache.clear();
 }
 
 void TextureManager::displayTextureMap()
@@ -400,6 +832,14 @@ void TextureManager::displayTextureMap()
 		std::cout << it->first << std::endl;
 		++it;
 	}
+
+	auto referenced = 0;
+	for (const auto& text_texture : m_textTextures)
+	{
+		referenced += (text_texture.second.references > 0) ? 1 : 0;
+	}
+	std::cout << "Text textures: " << m_textTextures.size() << " (" << referenced << " referenced), "
+		<< m_textTextureBytes / 1024 << " KB of a " << m_textTextureBudget / 1024 << " KB budget" << std::endl;
 }
 
 SpriteSheet* TextureManager::getSpriteSheet(const std::string & name)
@@ -4,8 +4,10 @@
 
 // Core Libraries
 #include <iostream>
+#include <list>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "glm/vec2.hpp"
 
@@ -16,6 +18,7 @@
 #include "SpriteSheet.h"
 #include "Animation.h"
 #include "GameObject.h"
+#include "TextureHandle.h"
 
 /* Singleton */
 class TextureManager
@@ -28,16 +31,26 @@ public:
 	}
 
 	// loading functions
-	bool load(const std::string& file_name, const std::string& id);
+	TextureHandle load(const std::string& file_name, const std::string& id);
 	bool loadSpriteSheet(const std::string& data_file_name, const std::string& texture_file_name, const std::string& sprite_sheet_name);
 
-	// drawing functions
+	// textures loaded between beginAtlas and endAtlas are packed into one or a few shared atlas textures
+	// sizes and handles are available straight away, the textures themselves only draw after endAtlas
+	// the packed pages are cached in ../Assets/cache and reused while the source files are unchanged
+	void beginAtlas(const std::string& atlas_name);
+	void endAtlas();
+
+	// drawing functions - the handle overloads skip the id lookup
+	void draw(TextureHandle handle, int x, int y, double angle = 0, int alpha = 255, bool centered = false, SDL_RendererFlip flip = SDL_FLIP_NONE);
+	void draw(TextureHandle handle, int x, int y, GameObject* g, double angle = 0, int alpha = 255, bool centered = false, SDL_RendererFlip flip = SDL_FLIP_NONE);
 	void draw(const std::string& id, int x, int y, double angle = 0, int alpha = 255, bool centered = false, SDL_RendererFlip flip = SDL_FLIP_NONE);
 	void draw(const std::string& id, int x, int y, GameObject* g, double angle = 0, int alpha = 255, bool centered = false, SDL_RendererFlip flip = SDL_FLIP_NONE);
 	void drawFrame(const std::string& id, int x, int y, int frame_width, int frame_height,
 		int& current_row, int& current_frame, int frame_number, int row_number, float speed_factor,
 		double angle, int alpha, bool centered = false, SDL_RendererFlip flip = SDL_FLIP_NONE);
 	void drawText(const std::string& id, int x, int y, double angle, int alpha, bool centered = false, SDL_RendererFlip flip = SDL_FLIP_NONE);
+	// draws part of a texture - src_rect is relative to the texture's own image, dest_rect is in world space
+	void drawRegion(TextureHandle handle, const SDL_Rect& src_rect, const SDL_Rect& dest_rect, double angle = 0, int alpha = 255, SDL_RendererFlip flip = SDL_FLIP_NONE);
 
 	// animation functions
 	void animateFrames(int frame_width, int frame_height, int frame_number, int row_number, float speed_factor, int& current_frame, int& current_row);
@@ -45,13 +58,23 @@ public:
 	SpriteSheet* getSpriteSheet(const std::string& name);
 
 	// texture utility functions
+	TextureHandle getHandle(const std::string& id) const;
 	SDL_Texture* getTexture(const std::string& id);
+	SDL_Texture* getTexture(TextureHandle handle) const;
 	void setColour(const std::string& id, Uint8 red, Uint8 green, Uint8 blue);
 	bool addTexture(const std::string& id, std::shared_ptr<SDL_Texture> texture);
 	void removeTexture(const std::string& id);
 	glm::vec2 getTextureSize(const std::string& id);
+	glm::vec2 getTextureSize(TextureHandle handle) const;
 	void setAlpha(const std::string& id, Uint8 new_alpha);
 
+	// text textures are rendered strings - they are reference counted by the labels showing them and the
+	// least recently used unreferenced ones are removed once their total size goes over the budget
+	bool addTextTexture(const std::string& id, std::shared_ptr<SDL_Texture> texture);
+	void acquireTextTexture(const std::string& id);
+	void releaseTextTexture(const std::string& id);
+	void setTextTextureBudget(size_t bytes);
+
 	// textureMap functions
 	int getTextureMapSize() const;
 	void displayTextureMap();
@@ -63,13 +86,73 @@ private:
 	TextureManager();
 	~TextureManager();
 
+	// a loaded texture and its size, queried once when it is added
+	struct TextureRecord
+	{
+		std::shared_ptr<SDL_Texture> texture; // may be an atlas shared with other records
+		int width;
+		int height;
+		SDL_Rect source; // where the image sits inside texture
+		SDL_Colour colour; // tint applied per draw rather than to the shared texture
+	};
+
+	// a texture waiting for endAtlas - surface is null when its place comes from the atlas cache
+	struct AtlasEntry
+	{
+		std::string id;
+		TextureHandle handle;
+		std::string fileName;
+		std::string fileStamp;
+		std::shared_ptr<SDL_Surface> surface;
+		int page; // -1 if the texture does not fit a page and gets a texture of its own
+		SDL_Rect rect;
+	};
+
+	struct TextTextureEntry
+	{
+		int references;
+		size_t bytes;
+		std::list<std::string>::iterator recentPosition;
+	};
+
 	// private utility functions
 	bool m_textureExists(const std::string& id);
+	void m_touchTextTexture(const std::string& id);
+	void m_evictTextTextures(const std::string& keep_id);
+	TextureHandle m_addRecord(std::shared_ptr<SDL_Texture> texture);
+	TextureHandle m_storeRecord(const TextureRecord& record);
+	const TextureRecord* m_getRecord(TextureHandle handle) const;
 	bool m_spriteSheetExists(const std::string& sprite_sheet_name);
+	// atlas functions
+	TextureHandle m_addAtlasEntry(const std::string& file_name, const std::string& id);
+	bool m_loadCachedAtlas(std::vector<std::shared_ptr<SDL_Texture>>& pages);
+	void m_packAtlas(std::vector<std::shared_ptr<SDL_Texture>>& pages);
+	void m_readAtlasCache();
+	void m_writeAtlasCache(int number_of_pages) const;
+	std::string m_getAtlasCachePath(int page = -1) const;
+	static std::string m_getFileStamp(const std::string& file_name);
+
+	static SDL_FRect m_toScreen(const SDL_Rect& dest_rect); // world space destination to screen space through the active camera
+	static void m_submit(const TextureRecord& record, SDL_Rect src_rect, const SDL_Rect& dest_rect, double angle, int alpha, SDL_RendererFlip flip);
 
 	// storage structures
-	std::unordered_map<std::string, std::shared_ptr<SDL_Texture>> m_textureMap;
+	std::vector<TextureRecord> m_textures; // indexed by TextureHandle
+	std::vector<TextureHandle> m_freeHandles; // slots of removed textures, reused by the next add
+	std::unordered_map<std::string, TextureHandle> m_textureMap;
 	std::unordered_map<std::string, SpriteSheet*> m_spriteSheetMap;
+
+	// text texture cache
+	std::unordered_map<std::string, TextTextureEntry> m_textTextures;
+	std::list<std::string> m_recentTextTextures; // most recently used first
+	size_t m_textTextureBytes;
+	size_t m_textTextureBudget;
+
+	// atlas packing state
+	bool m_isPackingAtlas;
+	std::string m_atlasName;
+	std::vector<AtlasEntry> m_atlasEntries;
+	std::unordered_map<std::string, AtlasEntry> m_atlasCache; // layout read from the cache file, by id
+	int m_numberOfCachedAtlasPages;
 };
 
 #endif /* defined(__TEXTURE_MANAGER__) */
\ No newline at end of file
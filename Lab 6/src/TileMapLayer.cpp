@@ -0,0 +1,325 @@
+#include "TileMapLayer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <glm/common.hpp>
+#include "Camera.h"
+#include "Config.h"
+#include "Renderer.h"
+#include "SpriteBatch.h"
+#include "TextureManager.h"
+
+TileMapLayer::TileMapLayer(const std::string& map_file_name, const std::string& sheet_file_name,
+	const std::string& texture_file_name, const std::string& texture_id, const int tile_size)
+	: m_columns(0), m_rows(0), m_tileSize(tile_size), m_sheetTileSize(0.0f, 0.0f), m_textureHandle(INVALID_TEXTURE_HANDLE),
+	m_chunkColumns(0), m_chunkRows(0), m_drawCount(0)
+{
+	std::vector<int> tile_ids;
+	if (m_loadMap(map_file_name, tile_ids) && m_loadSheet(sheet_file_name))
+	{
+		m_assignFrames(tile_ids);
+		m_textureHandle = TextureManager::Instance().load(texture_file_name, texture_id);
+	}
+
+	m_chunkColumns = (m_columns + Config::TILE_MAP_CHUNK_SIZE - 1) / Config::TILE_MAP_CHUNK_SIZE;
+	m_chunkRows = (m_rows + Config::TILE_MAP_CHUNK_SIZE - 1) / Config::TILE_MAP_CHUNK_SIZE;
+	m_chunks.resize(m_chunkColumns * m_chunkRows, { nullptr, false, 0 });
+
+	// sized so the scene can cull the whole layer
+	setWidth(m_columns * m_tileSize);
+	setHeight(m_rows * m_tileSize);
+	setIsCentered(false);
+	getTransform()->position = glm::vec2(0.0f, 0.0f);
+	getRigidBody()->isColliding = false;
+	setType(TILE_MAP_LAYER);
+}
+
+TileMapLayer::~TileMapLayer()
+= default;
+
+void TileMapLayer::draw()
+{
+	++m_drawCount;
+	if (m_tiles.empty()) return;
+
+	const auto origin = getTransform()->position;
+	const auto camera = Renderer::Instance().getCamera();
+	const auto view_bounds = (camera != nullptr) ? camera->getViewBounds() :
+		AABB{ glm::vec2(0.0f, 0.0f), glm::vec2(Config::SCREEN_WIDTH, Config::SCREEN_HEIGHT) };
+
+	// only the chunks under the view are visited, however big the map is
+	const auto chunk_extent = static_cast<float>(Config::TILE_MAP_CHUNK_SIZE * m_tileSize);
+	const auto first_col = std::max(static_cast<int>(std::floor((view_bounds.lowerBound.x - origin.x) / chunk_extent)), 0);
+	const auto last_col = std::min(static_cast<int>(std::floor((view_bounds.upperBound.x - origin.x) / chunk_extent)), m_chunkColumns - 1);
+	const auto first_row = std::max(static_cast<int>(std::floor((view_bounds.lowerBound.y - origin.y) / chunk_extent)), 0);
+	const auto last_row = std::min(static_cast<int>(std::floor((view_bounds.upperBound.y - origin.y) / chunk_extent)), m_chunkRows - 1);
+
+	const auto zoom = Renderer::Instance().getZoom();
+	for (auto chunk_row = first_row; chunk_row <= last_row; ++chunk_row)
+	{
+		for (auto chunk_col = first_col; chunk_col <= last_col; ++chunk_col)
+		{
+			auto& chunk = m_chunks[chunk_row * m_chunkColumns + chunk_col];
+			if (!chunk.isBaked && !m_bakeChunk(chunk, chunk_col, chunk_row))
+			{
+				// no render targets - the tiles are drawn one by one instead
+				m_drawChunkTiles(chunk_col, chunk_row, origin);
+				continue;
+			}
+			chunk.lastDrawn = m_drawCount;
+
+			const auto rect = m_getChunkRect(chunk_col, chunk_row);
+			const auto top_left = Renderer::Instance().worldToScreen(origin + glm::vec2(rect.x, rect.y));
+			SpriteBatch::Instance().add(chunk.texture.get(), { 0, 0, rect.w, rect.h },
+				{ top_left.x, top_left.y, rect.w * zoom, rect.h * zoom });
+		}
+	}
+
+	m_evictChunks();
+}
+
+void TileMapLayer::update()
+{
+}
+
+void TileMapLayer::clean()
+{
+	invalidateChunks();
+}
+
+int TileMapLayer::getColumns() const
+{
+	return m_columns;
+}
+
+int TileMapLayer::getRows() const
+{
+	return m_rows;
+}
+
+int TileMapLayer::getNumberOfBakedChunks() const
+{
+	return static_cast<int>(m_bakedChunks.size());
+}
+
+void TileMapLayer::invalidateChunks()
+{
+	// the textures go too - after a device reset they can't be drawn into again
+	for (auto& chunk : m_chunks)
+	{
+		chunk = { nullptr, false, 0 };
+	}
+	m_bakedChunks.clear();
+}
+
+bool TileMapLayer::m_loadMap(const std::string& file_name, std::vector<int>& tile_ids)
+{
+	std::ifstream map_file(file_name);
+	if (!map_file)
+	{
+		std::cout << "error opening tile map " << file_name << std::endl;
+		return false;
+	}
+
+	std::vector<std::vector<int>> rows;
+	std::string line;
+	while (std::getline(map_file, line))
+	{
+		std::vector<int> row;
+		std::stringstream line_stream(line);
+		std::string cell;
+		while (std::getline(line_stream, cell, ','))
+		{
+			row.push_back(static_cast<int>(std::strtol(cell.c_str(), nullptr, 10)));
+		}
+
+		if (!row.empty())
+		{
+			m_columns = std::max(m_columns, static_cast<int>(row.size()));
+			rows.push_back(row);
+		}
+	}
+	m_rows = static_cast<int>(rows.size());
+
+	// short rows are padded with empty cells
+	tile_ids.assign(m_columns * m_rows, -1);
+	for (auto row = 0; row < m_rows; ++row)
+	{
+		std::copy(rows[row].begin(), rows[row].end(), tile_ids.begin() + row * m_columns);
+	}
+	return m_rows > 0;
+}
+
+bool TileMapLayer::m_loadSheet(const std::string& file_name)
+{
+	std::ifstream sheet_file(file_name);
+	if (!sheet_file)
+	{
+		std::cout << "error opening sprite sheet " << file_name << std::endl;
+		return false;
+	}
+	const std::string sheet((std::istreambuf_iterator<char>(sheet_file)), std::istreambuf_iterator<char>());
+
+	// "frames": [[x, y, width, height, image, registration x, registration y], ...]
+	const auto frames_key = sheet.find("\"frames\"");
+	auto position = (frames_key != std::string::npos) ? sheet.find('[', frames_key) : std::string::npos;
+	if (position == std::string::npos)
+	{
+		std::cout << "no frames in sprite sheet " << file_name << std::endl;
+		return false;
+	}
+
+	++position;
+	while (position < sheet.size())
+	{
+		const auto frame_start = sheet.find_first_of("[]", position);
+		if (frame_start == std::string::npos || sheet[frame_start] == ']') break;
+
+		const auto frame_end = sheet.find(']', frame_start);
+		if (frame_end == std::string::npos) break;
+
+		std::vector<int> values;
+		std::stringstream frame_stream(sheet.substr(frame_start + 1, frame_end - frame_start - 1));
+		std::string value;
+		while (std::getline(frame_stream, value, ','))
+		{
+			values.push_back(static_cast<int>(std::strtol(value.c_str(), nullptr, 10)));
+		}
+		values.resize(7, 0);
+
+		// the registration point is drawn at the cell's top left, so trimmed images sit -registration into the cell
+		m_frames.push_back({ { values[0], values[1], values[2], values[3] }, glm::vec2(-values[5], -values[6]) });
+		m_sheetTileSize = glm::max(m_sheetTileSize, glm::vec2(values[2], values[3]));
+
+		position = frame_end + 1;
+	}
+
+	return !m_frames.empty();
+}
+
+void TileMapLayer::m_assignFrames(const std::vector<int>& tile_ids)
+{
+	// the sheets only hold the tiles the map uses, in ascending tile id order
+	std::vector<int> used_ids;
+	for (const auto tile_id : tile_ids)
+	{
+		if (tile_id >= 0) used_ids.push_back(tile_id);
+	}
+	std::sort(used_ids.begin(), used_ids.end());
+	used_ids.erase(std::unique(used_ids.begin(), used_ids.end()), used_ids.end());
+
+	if (used_ids.size() > m_frames.size())
+	{
+		std::cout << "tile map uses " << used_ids.size() << " tiles but the sheet has " << m_frames.size() << std::endl;
+	}
+
+	m_tiles.resize(tile_ids.size());
+	for (size_t i = 0; i < tile_ids.size(); ++i)
+	{
+		const auto used = std::lower_bound(used_ids.begin(), used_ids.end(), tile_ids[i]);
+		const auto frame = static_cast<int>(used - used_ids.begin());
+		m_tiles[i] = (tile_ids[i] >= 0 && frame < static_cast<int>(m_frames.size())) ? frame : -1;
+	}
+}
+
+SDL_Rect TileMapLayer::m_getChunkRect(const int chunk_col, const int chunk_row) const
+{
+	// chunks on the right and bottom edges are cut to the map
+	const auto chunk_size = Config::TILE_MAP_CHUNK_SIZE;
+	const auto first_col = chunk_col * chunk_size;
+	const auto first_row = chunk_row * chunk_size;
+	const auto columns = std::min(chunk_size, m_columns - first_col);
+	const auto rows = std::min(chunk_size, m_rows - first_row);
+	return { first_col * m_tileSize, first_row * m_tileSize, columns * m_tileSize, rows * m_tileSize };
+}
+
+bool TileMapLayer::m_bakeChunk(Chunk& chunk, const int chunk_col, const int chunk_row)
+{
+	const auto renderer = Renderer::Instance().getRenderer();
+	if (SDL_RenderTargetSupported(renderer) == SDL_FALSE)
+	{
+		return false;
+	}
+
+	const auto rect = m_getChunkRect(chunk_col, chunk_row);
+	if (chunk.texture == nullptr)
+	{
+		const auto texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, rect.w, rect.h);
+		if (texture == nullptr)
+		{
+			return false;
+		}
+		SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+		chunk.texture = Config::make_resource(texture);
+	}
+
+	// sprites queued so far belong to the previous target
+	SpriteBatch::Instance().flush();
+	const auto previous_target = SDL_GetRenderTarget(renderer);
+	const auto previous_camera = Renderer::Instance().getCamera();
+	SDL_SetRenderTarget(renderer, chunk.texture.get());
+	Renderer::Instance().setCamera(nullptr);
+
+	// empty cells stay transparent so the layers underneath show through
+	SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+	SDL_RenderClear(renderer);
+	SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+
+	// without a camera world units are the texture's pixels, so shift the chunk to its top left
+	m_drawChunkTiles(chunk_col, chunk_row, glm::vec2(-rect.x, -rect.y));
+	SpriteBatch::Instance().flush();
+
+	SDL_SetRenderTarget(renderer, previous_target);
+	Renderer::Instance().setCamera(previous_camera);
+
+	chunk.isBaked = true;
+	m_bakedChunks.push_back(static_cast<int>(&chunk - m_chunks.data()));
+	return true;
+}
+
+void TileMapLayer::m_drawChunkTiles(const int chunk_col, const int chunk_row, const glm::vec2 origin) const
+{
+	const auto scale = glm::vec2(m_tileSize, m_tileSize) / m_sheetTileSize;
+	const auto first_col = chunk_col * Config::TILE_MAP_CHUNK_SIZE;
+	const auto first_row = chunk_row * Config::TILE_MAP_CHUNK_SIZE;
+	const auto last_col = std::min(first_col + Config::TILE_MAP_CHUNK_SIZE, m_columns);
+	const auto last_row = std::min(first_row + Config::TILE_MAP_CHUNK_SIZE, m_rows);
+
+	for (auto row = first_row; row < last_row; ++row)
+	{
+		for (auto col = first_col; col < last_col; ++col)
+		{
+			const auto frame_index = m_tiles[row * m_columns + col];
+			if (frame_index < 0) continue;
+
+			const auto& frame = m_frames[frame_index];
+			const auto top_left = origin + glm::vec2(col * m_tileSize, row * m_tileSize) + frame.offset * scale;
+			const SDL_Rect dest_rect = {
+				static_cast<int>(std::round(top_left.x)), static_cast<int>(std::round(top_left.y)),
+				static_cast<int>(std::round(frame.source.w * scale.x)), static_cast<int>(std::round(frame.source.h * scale.y)) };
+			TextureManager::Instance().drawRegion(m_textureHandle, frame.source, dest_rect);
+		}
+	}
+}
+
+void TileMapLayer::m_evictChunks()
+{
+	// drop the least recently drawn chunks, but never one drawn this frame
+	while (static_cast<int>(m_bakedChunks.size()) > Config::TILE_MAP_CHUNK_CACHE)
+	{
+		const auto oldest = std::min_element(m_bakedChunks.begin(), m_bakedChunks.end(), [this](const int lhs, const int rhs)
+		{
+			return m_chunks[lhs].lastDrawn < m_chunks[rhs].lastDrawn;
+		});
+		if (m_chunks[*oldest].lastDrawn == m_drawCount) break;
+
+		m_chunks[*oldest] = { nullptr, false, 0 };
+		*oldest = m_bakedChunks.back();
+		m_bakedChunks.pop_back();
+	}
+}
@@ -0,0 +1,81 @@
+#pragma once
+#ifndef __TILE_MAP_LAYER__
+#define __TILE_MAP_LAYER__
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <SDL.h>
+#include <glm/vec2.hpp>
+#include "DisplayObject.h"
+#include "TextureHandle.h"
+
+/*
+ * One layer of a tile map loaded from a CSV of tile ids (-1 is empty) and its EaselJS sprite sheet.
+ * The map is split into square chunks of Config::TILE_MAP_CHUNK_SIZE tiles. A chunk is baked into a
+ * render-target texture the first time it comes into view and drawn with one copy from then on, so
+ * the cost of a frame depends on how many chunks the camera sees rather than on the size of the map.
+ * Only the chunks drawn most recently stay baked (Config::TILE_MAP_CHUNK_CACHE per layer).
+ * The layer's position is the world space top left of the map.
+ */
+class TileMapLayer final : public DisplayObject
+{
+public:
+	// tile_size is the size of one map cell in world space, the sheet's tiles are scaled to fit it
+	TileMapLayer(const std::string& map_file_name, const std::string& sheet_file_name,
+		const std::string& texture_file_name, const std::string& texture_id, int tile_size);
+	~TileMapLayer();
+
+	// Life Cycle Functions
+	void draw() override;
+	void update() override;
+	void clean() override;
+
+	int getColumns() const;
+	int getRows() const;
+	int getNumberOfBakedChunks() const;
+
+	// forgets every baked chunk - call when the renderer has lost the contents of its render targets
+	void invalidateChunks();
+
+private:
+	// where a tile's image sits in the sheet and how far it is drawn from the cell's top left
+	struct TileFrame
+	{
+		SDL_Rect source;
+		glm::vec2 offset;
+	};
+
+	struct Chunk
+	{
+		std::shared_ptr<SDL_Texture> texture; // null until the chunk is baked
+		bool isBaked;
+		unsigned int lastDrawn; // draw() call that last showed the chunk
+	};
+
+	bool m_loadMap(const std::string& file_name, std::vector<int>& tile_ids);
+	bool m_loadSheet(const std::string& file_name);
+	void m_assignFrames(const std::vector<int>& tile_ids);
+
+	SDL_Rect m_getChunkRect(int chunk_col, int chunk_row) const; // relative to the map's top left, in world units
+	bool m_bakeChunk(Chunk& chunk, int chunk_col, int chunk_row);
+	void m_drawChunkTiles(int chunk_col, int chunk_row, glm::vec2 origin) const;
+	void m_evictChunks();
+
+	int m_columns;
+	int m_rows;
+	int m_tileSize;
+	glm::vec2 m_sheetTileSize; // untrimmed size of a tile in the sheet
+
+	std::vector<TileFrame> m_frames;
+	std::vector<int> m_tiles; // frame index per cell, row by row, -1 if empty
+	TextureHandle m_textureHandle;
+
+	int m_chunkColumns;
+	int m_chunkRows;
+	std::vector<Chunk> m_chunks;
+	std::vector<int> m_bakedChunks; // indices into m_chunks
+	unsigned int m_drawCount;
+};
+
+#endif /* defined (__TILE_MAP_LAYER__) */
@@ -1,7 +1,9 @@
 #include "Util.h"
+#include <algorithm>
 #include <glm/gtc/constants.hpp>
 #include <glm/gtx/norm.hpp>
 #include <SDL.h>
+#include "DebugDraw.h"
 #include "Renderer.h"
 
 const float Util::EPSILON = glm::epsilon<float>();
@@ -358,135 +360,27 @@ glm::vec2 Util::rotatePoint(glm::vec2 point, const float angle, const glm::vec2
 	return point;
 }
 
-void Util::DrawLine(const glm::vec2 start, const glm::vec2 end, const glm::vec4 colour, SDL_Renderer* renderer)
+void Util::DrawLine(const glm::vec2 world_start, const glm::vec2 world_end, const glm::vec4 colour)
 {
-	int r = floor(colour.r * 255.0f);
-	int g = floor(colour.g * 255.0f);
-	int b = floor(colour.b * 255.0f);
-	int a = floor(colour.a * 255.0f);
-
-	SDL_SetRenderDrawColor(renderer, r, g, b, a);
-	SDL_RenderDrawLine(renderer, start.x, start.y, end.x, end.y);
-	SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+	DebugDraw::Instance().drawLine(world_start, world_end, colour);
 }
 
-void Util::DrawRect(const glm::vec2 position, const int width, const int height, const glm::vec4 colour, SDL_Renderer* renderer)
+void Util::DrawRect(const glm::vec2 world_position, const int world_width, const int world_height, const glm::vec4 colour)
 {
-	int r = floor(colour.r * 255.0f);
-	int g = floor(colour.g * 255.0f);
-	int b = floor(colour.b * 255.0f);
-	int a = floor(colour.a * 255.0f);
-
-	SDL_Rect rectangle;
-	rectangle.x = position.x;
-	rectangle.y = position.y;
-	rectangle.w = width;
-	rectangle.h = height;
-
-	SDL_SetRenderDrawColor(renderer, r, g, b, a);
-	SDL_RenderDrawRect(renderer, &rectangle);
-	SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+	DebugDraw::Instance().drawRect(world_position, world_width, world_height, colour);
 }
 
-void Util::DrawFilledRect(const glm::vec2 position, const int width, const int height, const glm::vec4 fill_colour, SDL_Renderer* renderer)
+void Util::DrawFilledRect(const glm::vec2 world_position, const int world_width, const int world_height, const glm::vec4 fill_colour)
 {
-	int r = floor(fill_colour.r * 255.0f);
-	int g = floor(fill_colour.g * 255.0f);
-	int b = floor(fill_colour.b * 255.0f);
-	int a = floor(fill_colour.a * 255.0f);
-
-	SDL_Rect rectangle;
-	rectangle.x = position.x;
-	rectangle.y = position.y;
-	rectangle.w = width;
-	rectangle.h = height;
-
-	SDL_SetRenderDrawColor(renderer, r, g, b, a);
-	SDL_RenderFillRect(renderer, &rectangle);
-	SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+	DebugDraw::Instance().drawFilledRect(world_position, world_width, world_height, fill_colour);
 }
 
-void Util::DrawCircle(const glm::vec2 centre, const int radius, const glm::vec4 colour, const ShapeType type, SDL_Renderer* renderer)
+void Util::DrawCircle(const glm::vec2 world_centre, const int world_radius, const glm::vec4 colour, const ShapeType type)
 {
-	int r = floor(colour.r * 255.0f);
-	int g = floor(colour.g * 255.0f);
-	int b = floor(colour.b * 255.0f);
-	int a = floor(colour.a * 255.0f);
-
-	SDL_SetRenderDrawColor(renderer, r, g, b, a);
-	const int diameter = floor(radius * 2.0f);
-
-	int x = (radius - 1);
-	int y = 0;
-	int tx = 1;
-	int ty = 1;
-	int error = (tx - diameter);
-
-	while (x >= y)
-	{
-		switch (type)
-		{
-		case SEMI_CIRCLE_TOP:
-			//  Each of the following renders an octant of the circle
-			SDL_RenderDrawPoint(renderer, centre.x + x, centre.y - y);
-			SDL_RenderDrawPoint(renderer, centre.x - x, centre.y - y);
-			SDL_RenderDrawPoint(renderer, centre.x + y, centre.y - x);
-			SDL_RenderDrawPoint(renderer, centre.x - y, centre.y - x);
-			break;
-		case SEMI_CIRCLE_BOTTOM:
-			//  Each of the following renders an octant of the circle
-			SDL_RenderDrawPoint(renderer, centre.x + x, centre.y + y); // bottom right
-			SDL_RenderDrawPoint(renderer, centre.x - x, centre.y + y); // bottom left
-			SDL_RenderDrawPoint(renderer, centre.x + y, centre.y + x); // bottom right
-			SDL_RenderDrawPoint(renderer, centre.x - y, centre.y + x); // bottom left
-			break;
-		case SEMI_CIRCLE_LEFT:
-			//  Each of the following renders an octant of the circle
-			SDL_RenderDrawPoint(renderer, centre.x - x, centre.y - y);
-			SDL_RenderDrawPoint(renderer, centre.x - x, centre.y + y);
-			SDL_RenderDrawPoint(renderer, centre.x - y, centre.y - x);
-			SDL_RenderDrawPoint(renderer, centre.x - y, centre.y + x);
-			break;
-		case SEMI_CIRCLE_RIGHT:
-			//  Each of the following renders an octant of the circle
-			SDL_RenderDrawPoint(renderer, centre.x + x, centre.y - y);
-			SDL_RenderDrawPoint(renderer, centre.x + x, centre.y + y);
-			SDL_RenderDrawPoint(renderer, centre.x + y, centre.y - x);
-			SDL_RenderDrawPoint(renderer, centre.x + y, centre.y + x);
-			break;
-		case SYMMETRICAL:
-			//  Each of the following renders an octant of the circle
-			SDL_RenderDrawPoint(renderer, centre.x + x, centre.y - y);
-			SDL_RenderDrawPoint(renderer, centre.x + x, centre.y + y);
-			SDL_RenderDrawPoint(renderer, centre.x - x, centre.y - y);
-			SDL_RenderDrawPoint(renderer, centre.x - x, centre.y + y);
-			SDL_RenderDrawPoint(renderer, centre.x + y, centre.y - x);
-			SDL_RenderDrawPoint(renderer, centre.x + y, centre.y + x);
-			SDL_RenderDrawPoint(renderer, centre.x - y, centre.y - x);
-			SDL_RenderDrawPoint(renderer, centre.x - y, centre.y + x);
-			break;
-		}
-
-
-		if (error <= 0)
-		{
-			++y;
-			error += ty;
-			ty += 2;
-		}
-
-		if (error > 0)
-		{
-			--x;
-			tx += 2;
-			error += (tx - diameter);
-		}
-	}
-
-	SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+	DebugDraw::Instance().drawCircle(world_centre, world_radius, colour, type);
 }
 
-void Util::DrawCapsule(const glm::vec2 position, const int width, const int height, const glm::vec4 colour, SDL_Renderer* renderer)
+void Util::DrawCapsule(const glm::vec2 position, const int width, const int height, const glm::vec4 colour)
 {
 	int diameter;
 	int radius;
@@ -497,46 +391,53 @@ void Util::DrawCapsule(const glm::vec2 position, const int width, const int heig
 		// Horizontal Capsule
 		diameter = height;
 		radius = halfHeight * 0.5f;
-		DrawCircle(glm::vec2(position.x - halfWidth + halfHeight, position.y), halfHeight, colour, SEMI_CIRCLE_LEFT, renderer);
-		DrawCircle(glm::vec2(position.x + halfWidth - halfHeight, position.y), halfHeight, colour, SEMI_CIRCLE_RIGHT, renderer);
-		DrawLine(glm::vec2(position.x - halfWidth + halfHeight, position.y - halfHeight), glm::vec2(position.x + halfWidth - halfHeight, position.y - halfHeight), colour, renderer);
-		DrawLine(glm::vec2(position.x - halfWidth + halfHeight, position.y + halfHeight), glm::vec2(position.x + halfWidth - halfHeight, position.y + halfHeight), colour, renderer);
+		DrawCircle(glm::vec2(position.x - halfWidth + halfHeight, position.y), halfHeight, colour, SEMI_CIRCLE_LEFT);
+		DrawCircle(glm::vec2(position.x + halfWidth - halfHeight, position.y), halfHeight, colour, SEMI_CIRCLE_RIGHT);
+		DrawLine(glm::vec2(position.x - halfWidth + halfHeight, position.y - halfHeight), glm::vec2(position.x + halfWidth - halfHeight, position.y - halfHeight), colour);
+		DrawLine(glm::vec2(position.x - halfWidth + halfHeight, position.y + halfHeight), glm::vec2(position.x + halfWidth - halfHeight, position.y + halfHeight), colour);
 	}
 	else if (width < height)
 	{
 		// Vertical Capsule
 		diameter = width;
 		radius = halfWidth * 0.5f;
-		DrawCircle(glm::vec2(position.x, position.y - halfHeight + radius), radius, colour, SEMI_CIRCLE_TOP, renderer);
-		DrawCircle(glm::vec2(position.x, position.y + halfHeight - radius), radius, colour, SEMI_CIRCLE_BOTTOM, renderer);
-		DrawLine(glm::vec2(position.x - radius, position.y - halfHeight + radius), glm::vec2(position.x - halfWidth * 0.5f, position.y + halfHeight * 0.5f), colour, renderer);
-		DrawLine(glm::vec2(position.x + radius, position.y - halfHeight + radius), glm::vec2(position.x + halfWidth * 0.5f, position.y + halfHeight * 0.5f), colour, renderer);
+		DrawCircle(glm::vec2(position.x, position.y - halfHeight + radius), radius, colour, SEMI_CIRCLE_TOP);
+		DrawCircle(glm::vec2(position.x, position.y + halfHeight - radius), radius, colour, SEMI_CIRCLE_BOTTOM);
+		DrawLine(glm::vec2(position.x - radius, position.y - halfHeight + radius), glm::vec2(position.x - halfWidth * 0.5f, position.y + halfHeight * 0.5f), colour);
+		DrawLine(glm::vec2(position.x + radius, position.y - halfHeight + radius), glm::vec2(position.x + halfWidth * 0.5f, position.y + halfHeight * 0.5f), colour);
 	}
 	else
 	{
 		// Circle
 		diameter = floor(height * 2.0f);
 		radius = width;
-		DrawCircle(position, radius = halfWidth, colour, SYMMETRICAL, renderer);
+		DrawCircle(position, radius = halfWidth, colour, SYMMETRICAL);
 	}
 }
 
-float Util::getClosestEdge(glm::vec2 vecA, GameObject* object)
+float Util::getClosestEdge(const glm::vec2 vecA, const GameObject* object)
+{
+	return sqrt(getClosestEdgeSquared(vecA, object));
+}
+
+/**
+* Returns the squared distance from vecA to the closest edge midpoint of object
+* Compare against squared distances to skip the square root
+*/
+float Util::getClosestEdgeSquared(const glm::vec2 vecA, const GameObject* object)
 {
-	auto targOffset = glm::vec2(object->getWidth() * 0.5f, object->getHeight() * 0.5f);
-	auto targTopLeft = object->getTransform()->position - targOffset;
-	SDL_Rect rect = { (int)targTopLeft.x, (int)targTopLeft.y, object->getWidth(), object->getHeight() };
+	const auto halfWidth = object->getWidth() * 0.5f;
+	const auto halfHeight = object->getHeight() * 0.5f;
+	const auto centre = object->getTransform()->position;
 
-	glm::vec2 sides[4] = { { rect.x + rect.w / 2, rect.y }, // top
-						   { rect.x + rect.w / 2, rect.y + rect.h }, // bottom
-						   { rect.x, rect.y + rect.h / 2 }, // left
-						   { rect.x + rect.w, rect.y + rect.h / 2 } }; // right
-	float dist = Util::distance(vecA, sides[0]);
+	const glm::vec2 sides[4] = { { centre.x, centre.y - halfHeight }, // top
+								 { centre.x, centre.y + halfHeight }, // bottom
+								 { centre.x - halfWidth, centre.y }, // left
+								 { centre.x + halfWidth, centre.y } }; // right
+	auto dist = Util::squaredDistance(vecA, sides[0]);
 	for (int i = 1; i < 4; i++)
 	{
-		float distNew = Util::distance(vecA, sides[i]);
-		if (distNew < dist)
-			dist = distNew;
+		dist = std::min(dist, Util::squaredDistance(vecA, sides[i]));
 	}
 	return dist;
 }
\ No newline at end of file
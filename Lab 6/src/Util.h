@@ -2,8 +2,8 @@
 #ifndef __UTIL__
 #define __UTIL__
 
-#include "GLM/vec2.hpp"
-#include "GLM/vec4.hpp"
+#include "glm/vec2.hpp"
+#include "glm/vec4.hpp"
 #include "ShapeType.h"
 #include <SDL.h>
 #include "Renderer.h"
@@ -60,14 +60,15 @@ public:
 
 	static glm::vec2 rotatePoint(glm::vec2 point, float angle, glm::vec2 pivot);
 
-	// debugging convenience functions
-	static void DrawLine(glm::vec2 start, glm::vec2 end, glm::vec4 colour = glm::vec4(0.0f, 1.0f, 0.0f, 1.0f), SDL_Renderer* renderer = Renderer::Instance().getRenderer());
-	static void DrawRect(glm::vec2 position, int width, int height, glm::vec4 colour = glm::vec4(0.0f, 1.0f, 0.0f, 1.0f), SDL_Renderer* renderer = Renderer::Instance().getRenderer());
-	static void DrawFilledRect(glm::vec2 position, int width, int height, glm::vec4 fill_colour = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f), SDL_Renderer* renderer = Renderer::Instance().getRenderer());
-	static void DrawCircle(glm::vec2 centre, int radius, glm::vec4 colour = glm::vec4(0.0f, 1.0f, 0.0f, 1.0f), ShapeType type = SYMMETRICAL, SDL_Renderer* renderer = Renderer::Instance().getRenderer());
-	static void DrawCapsule(glm::vec2 position, int width, int height, glm::vec4 colour = glm::vec4(0.0f, 1.0f, 0.0f, 1.0f), SDL_Renderer* renderer = Renderer::Instance().getRenderer());
+	// debugging convenience functions - the shapes are queued in DebugDraw and drawn when it is flushed
+	static void DrawLine(glm::vec2 start, glm::vec2 end, glm::vec4 colour = glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
+	static void DrawRect(glm::vec2 position, int width, int height, glm::vec4 colour = glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
+	static void DrawFilledRect(glm::vec2 position, int width, int height, glm::vec4 fill_colour = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
+	static void DrawCircle(glm::vec2 centre, int radius, glm::vec4 colour = glm::vec4(0.0f, 1.0f, 0.0f, 1.0f), ShapeType type = SYMMETRICAL);
+	static void DrawCapsule(glm::vec2 position, int width, int height, glm::vec4 colour = glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
 
-	static float getClosestEdge(glm::vec2 vecA, GameObject* object);
+	static float getClosestEdge(glm::vec2 vecA, const GameObject* object);
+	static float getClosestEdgeSquared(glm::vec2 vecA, const GameObject* object);
 };
 
 
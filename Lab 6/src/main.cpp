@@ -1,21 +1,164 @@
 // Core Libraries
-#include <crtdbg.h>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <random>
+#include <vector>
+
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 
+#include "CollisionManager.h"
 #include "Game.h"
 
 const int FPS = 60;
 const int DELAY_TIME = 1000.0f / FPS;
+const Uint32 DEFAULT_HEADLESS_FRAMES = 600;
+const Uint32 DEFAULT_BENCHMARK_PAIRS = 65536;
+const int BENCHMARK_REPEATS = 20;
 
-int main(int argc, char* args[])
+// steps the scenes as fast as they go with a fixed delta time, then reports the time taken
+int runHeadless(const Uint32 frame_count)
 {
-	Uint32 frameStart, frameTime;
-	UINT32 frames = 0;
+	if (!TheGame::Instance().initHeadless(Config::SCREEN_WIDTH, Config::SCREEN_HEIGHT))
+	{
+		return 1;
+	}
+
+	// fixed, so runs are repeatable whatever the machine
+	TheGame::Instance().setDeltaTime(1.0f / FPS);
+
+	Uint32 frames = 0;
+	const auto start = SDL_GetPerformanceCounter();
+
+	while (TheGame::Instance().isRunning() && frames < frame_count)
+	{
+		TheGame::Instance().handleEvents();
+		TheGame::Instance().update();
+		TheGame::Instance().render();
+
+		frames++;
+		TheGame::Instance().setFrames(frames);
+	}
+
+	const auto seconds = static_cast<double>(SDL_GetPerformanceCounter() - start) / SDL_GetPerformanceFrequency();
+	std::cout << frames << " frames in " << seconds << " s (" << ((seconds > 0.0) ? frames / seconds : 0.0) << " frames per second)" << std::endl;
 
+	TheGame::Instance().clean();
+	return 0;
+}
+
+// the four edge test lineRectCheck used before segmentAABBCheck - kept here as the benchmark's baseline
+bool edgeSegmentAABBCheck(const glm::vec2 line_start, const glm::vec2 line_end, const glm::vec2 box_min, const glm::vec2 box_max)
+{
+	const auto left = CollisionManager::lineLineCheck(line_start, line_end, box_min, glm::vec2(box_min.x, box_max.y));
+	const auto right = CollisionManager::lineLineCheck(line_start, line_end, glm::vec2(box_max.x, box_min.y), box_max);
+	const auto top = CollisionManager::lineLineCheck(line_start, line_end, box_min, glm::vec2(box_max.x, box_min.y));
+	const auto bottom = CollisionManager::lineLineCheck(line_start, line_end, glm::vec2(box_min.x, box_max.y), box_max);
+	return left || right || top || bottom;
+}
+
+// times the edge test against the slab test over the same random segments and boxes, then reports both
+int runSegmentAABBBenchmark(const Uint32 pair_count)
+{
+	// fixed seed, so every run tests the same pairs
+	std::mt19937 generator(30);
+	std::uniform_real_distribution<float> position(0.0f, static_cast<float>(Config::SCREEN_WIDTH));
+	std::uniform_real_distribution<float> size(10.0f, 120.0f);
+
+	std::vector<glm::vec2> line_starts(pair_count), line_ends(pair_count), box_mins(pair_count), box_maxes(pair_count);
+	for (Uint32 i = 0; i < pair_count; ++i)
+	{
+		line_starts[i] = glm::vec2(position(generator), position(generator));
+		line_ends[i] = glm::vec2(position(generator), position(generator));
+		box_mins[i] = glm::vec2(position(generator), position(generator));
+		box_maxes[i] = box_mins[i] + glm::vec2(size(generator), size(generator));
+	}
+
+	std::vector<char> edge_hits(pair_count), slab_hits(pair_count);
+	const auto frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+	const auto tests = static_cast<double>(pair_count) * BENCHMARK_REPEATS;
+
+	auto start = SDL_GetPerformanceCounter();
+	for (auto repeat = 0; repeat < BENCHMARK_REPEATS; ++repeat)
+	{
+		for (Uint32 i = 0; i < pair_count; ++i)
+		{
+			edge_hits[i] = edgeSegmentAABBCheck(line_starts[i], line_ends[i], box_mins[i], box_maxes[i]);
+		}
+	}
+	const auto edge_seconds = static_cast<double>(SDL_GetPerformanceCounter() - start) / frequency;
+
+	start = SDL_GetPerformanceCounter();
+	for (auto repeat = 0; repeat < BENCHMARK_REPEATS; ++repeat)
+	{
+		for (Uint32 i = 0; i < pair_count; ++i)
+		{
+			float t;
+			glm::vec2 normal;
+			slab_hits[i] = CollisionManager::segmentAABBCheck(line_starts[i], line_ends[i], box_mins[i], box_maxes[i], t, normal);
+		}
+	}
+	const auto slab_seconds = static_cast<double>(SDL_GetPerformanceCounter() - start) / frequency;
+
+	// the slab test also counts segments that lie wholly inside the box, the edge test does not
+	Uint32 hits = 0, inside = 0, mismatches = 0;
+	for (Uint32 i = 0; i < pair_count; ++i)
+	{
+		hits += slab_hits[i];
+		if (edge_hits[i] == slab_hits[i]) continue;
+
+		const auto is_inside = [&](const glm::vec2 point)
+		{
+			return point.x >= box_mins[i].x && point.x <= box_maxes[i].x && point.y >= box_mins[i].y && point.y <= box_maxes[i].y;
+		};
+		if (is_inside(line_starts[i]) && is_inside(line_ends[i]))
+		{
+			inside++;
+		}
+		else
+		{
+			mismatches++;
+		}
+	}
+
+	std::cout << pair_count << " segment/box pairs x " << BENCHMARK_REPEATS << ", " << hits << " hits" << std::endl;
+	std::cout << "edge test: " << edge_seconds * 1.0e9 / tests << " ns per test" << std::endl;
+	std::cout << "slab test: " << slab_seconds * 1.0e9 / tests << " ns per test ("
+		<< ((slab_seconds > 0.0) ? edge_seconds / slab_seconds : 0.0) << "x)" << std::endl;
+	std::cout << inside << " segments inside a box, " << mismatches << " other disagreements" << std::endl;
+
+	return (mismatches > 0) ? 1 : 0;
+}
+
+int main(int argc, char* args[])
+{
+#ifdef _WIN32
 	// show console
 	AllocConsole();
 	freopen("CON", "w", stdout);
+#endif
+
+	// --headless [frames] runs the simulation without a window, renderer output or audio device
+	// --bench-segment-aabb [pairs] compares the segment/box tests and exits
+	for (auto i = 1; i < argc; ++i)
+	{
+		if (std::strcmp(args[i], "--headless") == 0)
+		{
+			const auto frame_count = (i + 1 < argc) ? static_cast<Uint32>(std::strtoul(args[i + 1], nullptr, 10)) : 0;
+			return runHeadless((frame_count > 0) ? frame_count : DEFAULT_HEADLESS_FRAMES);
+		}
+
+		if (std::strcmp(args[i], "--bench-segment-aabb") == 0)
+		{
+			const auto pair_count = (i + 1 < argc) ? static_cast<Uint32>(std::strtoul(args[i + 1], nullptr, 10)) : 0;
+			return runSegmentAABBBenchmark((pair_count > 0) ? pair_count : DEFAULT_BENCHMARK_PAIRS);
+		}
+	}
+
+	Uint32 frameStart, frameTime;
+	Uint32 frames = 0;
 
 	TheGame::Instance().init("SDLEngine v0.27", 100, 100, 800, 600, false);
 
@@ -47,4 +190,3 @@ int main(int argc, char* args[])
 	TheGame::Instance().clean();
 	return 0;
 }
-
@@ -6,9 +6,12 @@
 
 Ship::Ship() : m_maxSpeed(10.0f)
 {
-	TextureManager::Instance().load("../Assets/textures/ship3.png", "ship");
+	// agents move every frame, so keep their components with the other movers
+	useComponentManager();
 
-	auto size = TextureManager::Instance().getTextureSize("ship");
+	m_textureHandle = TextureManager::Instance().load("../Assets/textures/ship3.png", "ship");
+
+	auto size = TextureManager::Instance().getTextureSize(m_textureHandle);
 	setWidth(size.x);
 	setHeight(size.y);
 
@@ -16,6 +19,7 @@ Ship::Ship() : m_maxSpeed(10.0f)
 	getRigidBody()->velocity = glm::vec2(0.0f, 0.0f);
 	getRigidBody()->acceleration = glm::vec2(0.0f, 0.0f);
 	getRigidBody()->isColliding = false;
+	setCollisionShape(ORIENTED_RECTANGLE);
 	setType(AGENT);
 
 	setCurrentHeading(0.0f);// current facing angle
@@ -37,7 +41,7 @@ void Ship::draw()
 	const auto y = getTransform()->position.y;
 
 	// draw the ship
-	TextureManager::Instance().draw("ship", x, y, getCurrentHeading(), 255, true);
+	TextureManager::Instance().draw(m_textureHandle, x, y, getCurrentHeading(), 255, true);
 
 	// draw LOS
 	Util::DrawLine(getTransform()->position, getTransform()->position + getCurrentDirection() * getLOSDistance(), getLOSColour());
@@ -84,7 +88,7 @@ void Ship::moveBack()
 
 void Ship::move()
 {
-	getTransform()->position += getRigidBody()->velocity;
+	sweepMove(getRigidBody()->velocity);
 	getRigidBody()->velocity *= 0.9f;
 }
 
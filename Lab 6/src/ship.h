@@ -38,6 +38,8 @@ private:
 	float m_maxSpeed;
 	float m_turnRate;
 
+	TextureHandle m_textureHandle;
+
 };
 
 